@@ -1,8 +1,20 @@
-#include <gmpxx.h>
 #include "seg_intersection_tests.h"
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <cfloat>
+#include <cstdint>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 using namespace std;
 
@@ -16,22 +28,164 @@ struct segment {
     point p2;
 };
 
+// Adaptive exact orientation test (Shewchuk, "Adaptive Precision Floating-Point
+// Arithmetic and Fast Robust Geometric Predicates") carried out in long double.
+const long double expansion_eps = LDBL_EPSILON / 2;
+const long double splitter = 4294967297.0L;
+const long double ccw_errbound_a = (3.0L + 16.0L * expansion_eps) * expansion_eps;
+const long double ccw_errbound_b = (2.0L + 12.0L * expansion_eps) * expansion_eps;
+const long double ccw_errbound_c = (9.0L + 64.0L * expansion_eps) * expansion_eps * expansion_eps;
+const long double result_errbound = (3.0L + 8.0L * expansion_eps) * expansion_eps;
+
+inline void two_sum(long double a, long double b, long double& x, long double& y) {
+    x = a + b;
+    long double bvirt = x - a;
+    long double avirt = x - bvirt;
+    y = (a - avirt) + (b - bvirt);
+}
+
+inline long double two_diff_tail(long double a, long double b, long double x) {
+    long double bvirt = a - x;
+    long double avirt = x + bvirt;
+    return (a - avirt) + (bvirt - b);
+}
+
+inline void two_diff(long double a, long double b, long double& x, long double& y) {
+    x = a - b;
+    y = two_diff_tail(a, b, x);
+}
+
+inline void split(long double a, long double& hi, long double& lo) {
+    long double c = splitter * a;
+    long double abig = c - a;
+    hi = c - abig;
+    lo = a - hi;
+}
+
+inline void two_product(long double a, long double b, long double& x, long double& y) {
+    x = a * b;
+    long double ahi, alo, bhi, blo;
+    split(a, ahi, alo);
+    split(b, bhi, blo);
+    long double err1 = x - ahi * bhi;
+    long double err2 = err1 - alo * bhi;
+    long double err3 = err2 - ahi * blo;
+    y = alo * blo - err3;
+}
+
+inline void two_two_diff(long double a1, long double a0, long double b1, long double b0, long double x[4]) {
+    long double i, j, k;
+    two_diff(a0, b0, i, x[0]);
+    two_sum(a1, i, j, k);
+    two_diff(k, b1, i, x[1]);
+    two_sum(j, i, x[3], x[2]);
+}
+
+int expansion_sum(int elen, const long double e[], int flen, const long double f[], long double h[]) {
+    int ei = 0;
+    int fi = 0;
+    int hi = 0;
+    long double q, qnew, hh;
+    if ((f[0] > e[0]) == (f[0] > -e[0])) {
+        q = e[ei++];
+    } else {
+        q = f[fi++];
+    }
+    while (ei < elen || fi < flen) {
+        if (fi == flen || (ei < elen && (f[fi] > e[ei]) == (f[fi] > -e[ei]))) {
+            two_sum(q, e[ei++], qnew, hh);
+        } else {
+            two_sum(q, f[fi++], qnew, hh);
+        }
+        q = qnew;
+        if (hh != 0) {
+            h[hi++] = hh;
+        }
+    }
+    if (q != 0 || hi == 0) {
+        h[hi++] = q;
+    }
+    return hi;
+}
+
+long double orient2d_adapt(const point& a, const point& b, const point& c, long double detsum) {
+    long double acx = a.x - c.x;
+    long double bcx = b.x - c.x;
+    long double acy = a.y - c.y;
+    long double bcy = b.y - c.y;
+    long double l, ltail, r, rtail;
+    two_product(acx, bcy, l, ltail);
+    two_product(acy, bcx, r, rtail);
+    long double bexp[4];
+    two_two_diff(l, ltail, r, rtail, bexp);
+    long double det = bexp[0] + bexp[1] + bexp[2] + bexp[3];
+    long double errbound = ccw_errbound_b * detsum;
+    if (det >= errbound || -det >= errbound) {
+        return det;
+    }
+
+    long double acxtail = two_diff_tail(a.x, c.x, acx);
+    long double bcxtail = two_diff_tail(b.x, c.x, bcx);
+    long double acytail = two_diff_tail(a.y, c.y, acy);
+    long double bcytail = two_diff_tail(b.y, c.y, bcy);
+    if (acxtail == 0 && acytail == 0 && bcxtail == 0 && bcytail == 0) {
+        return det;
+    }
+    errbound = ccw_errbound_c * detsum + result_errbound * abs(det);
+    det += (acx * bcytail + bcy * acxtail) - (acy * bcxtail + bcx * acytail);
+    if (det >= errbound || -det >= errbound) {
+        return det;
+    }
+
+    long double u[4], c1[8], c2[12], d[16];
+    two_product(acxtail, bcy, l, ltail);
+    two_product(acytail, bcx, r, rtail);
+    two_two_diff(l, ltail, r, rtail, u);
+    int c1len = expansion_sum(4, bexp, 4, u, c1);
+    two_product(acx, bcytail, l, ltail);
+    two_product(acy, bcxtail, r, rtail);
+    two_two_diff(l, ltail, r, rtail, u);
+    int c2len = expansion_sum(c1len, c1, 4, u, c2);
+    two_product(acxtail, bcytail, l, ltail);
+    two_product(acytail, bcxtail, r, rtail);
+    two_two_diff(l, ltail, r, rtail, u);
+    int dlen = expansion_sum(c2len, c2, 4, u, d);
+    return d[dlen - 1];
+}
+
+long double orient2d(const point& a, const point& b, const point& c) {
+    long double l = (a.x - c.x) * (b.y - c.y);
+    long double r = (a.y - c.y) * (b.x - c.x);
+    long double det = l - r;
+    long double detsum;
+    if (l > 0) {
+        if (r <= 0) {
+            return det;
+        }
+        detsum = l + r;
+    } else if (l < 0) {
+        if (r >= 0) {
+            return det;
+        }
+        detsum = -l - r;
+    } else {
+        return det;
+    }
+    long double errbound = ccw_errbound_a * detsum;
+    if (det >= errbound || -det >= errbound) {
+        return det;
+    }
+    return orient2d_adapt(a, b, c, detsum);
+}
+
 int orientation(const segment& s, const point& p) {
-    long double o = (p.x - s.p1.x) * (s.p2.y - s.p1.y) - (p.y - s.p1.y) * (s.p2.x - s.p1.x);
-    if (o < -1e-9) {
+    long double o = orient2d(p, s.p2, s.p1);
+    if (o < 0) {
         return -1;
-    } else if (o > 1e-9) {
+    } else if (o > 0) {
         return 1;
-    } else {
-        mpq_class px = (double) p.x;
-        mpq_class sp1x = (double) s.p1.x;
-        mpq_class sp2x = (double) s.p2.x;
-        mpq_class sp2y = (double) s.p2.y;
-        mpq_class sp1y = (double) s.p1.y;
-        mpq_class py = (double) p.y;
-        mpq_class o_mpq = (px - sp1x) * (sp2y - sp1y) - (py - sp1y) * (sp2x - sp1x);
-        return mpq_sgn(o_mpq.get_mpq_t());
     }
+    return 0;
 }
 
 bool between(const segment& s, const point& p) {
@@ -42,10 +196,444 @@ bool between(const segment& s, const point& p) {
     return p.x >= lx && p.x <= rx && p.y >= ly && p.y <= ry;
 }
 
-int main() {
+bool intersect(const segment& seg1, const segment& seg2, int o1, int o2, int o3, int o4) {
+    bool pr1 = o1 != o2;
+    bool pr2 = o3 != o4;
+
+    if (pr1 & pr2) {
+        return true;
+    } else if (!pr1 && o1 != 0 || !pr2 && o3 != 0) {
+        return false;
+    } else {
+        return between(seg1, seg2.p1) || between(seg1, seg2.p2) || between(seg2, seg1.p1) || between(seg2, seg1.p2);
+    }
+}
+
+bool intersect(const segment& seg1, const segment& seg2) {
+    int o1 = orientation(seg1, seg2.p1);
+    int o2 = orientation(seg1, seg2.p2);
+    int o3 = orientation(seg2, seg1.p1);
+    int o4 = orientation(seg2, seg1.p2);
+    return intersect(seg1, seg2, o1, o2, o3, o4);
+}
+
+const double orient_eps = DBL_EPSILON / 2;
+const double orient_errbound = (3.0 + 16.0 * orient_eps) * orient_eps;
+
+int orientation_filter(double ax, double ay, double bx, double by, double px, double py) {
+    double l = (px - ax) * (by - ay);
+    double r = (py - ay) * (bx - ax);
+    double o = l - r;
+    double bound = orient_errbound * (abs(l) + abs(r));
+    if (o > bound) {
+        return 1;
+    } else if (-o > bound) {
+        return -1;
+    }
+    return 2;
+}
+
+#ifdef __AVX2__
+void orientation_filter4(__m256d ax, __m256d ay, __m256d bx, __m256d by, __m256d px, __m256d py, int& pos, int& neg) {
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    __m256d l = _mm256_mul_pd(_mm256_sub_pd(px, ax), _mm256_sub_pd(by, ay));
+    __m256d r = _mm256_mul_pd(_mm256_sub_pd(py, ay), _mm256_sub_pd(bx, ax));
+    __m256d o = _mm256_sub_pd(l, r);
+    __m256d bound = _mm256_mul_pd(_mm256_set1_pd(orient_errbound),
+                                  _mm256_add_pd(_mm256_andnot_pd(sign, l), _mm256_andnot_pd(sign, r)));
+    pos = _mm256_movemask_pd(_mm256_cmp_pd(o, bound, _CMP_GT_OQ));
+    neg = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_xor_pd(o, sign), bound, _CMP_GT_OQ));
+}
+
+void transpose4(const double* p, __m256d c[4]) {
+    __m256d r0 = _mm256_loadu_pd(p);
+    __m256d r1 = _mm256_loadu_pd(p + 8);
+    __m256d r2 = _mm256_loadu_pd(p + 16);
+    __m256d r3 = _mm256_loadu_pd(p + 24);
+    __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+    __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+    __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+    __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+    c[0] = _mm256_permute2f128_pd(t0, t2, 0x20);
+    c[1] = _mm256_permute2f128_pd(t1, t3, 0x20);
+    c[2] = _mm256_permute2f128_pd(t0, t2, 0x31);
+    c[3] = _mm256_permute2f128_pd(t1, t3, 0x31);
+}
+#endif
+
+struct segment_batch {
+    vector<double> x1, y1, x2, y2, x3, y3, x4, y4;
+    vector<char> inexact;
+    const vector<long double>* inp;
+
+    uint size() const {
+        return x1.size();
+    }
+
+    bool skip(uint i) const {
+        return inexact[i];
+    }
+
+    bool intersect_skipped(uint i) const {
+        const long double* v = &(*inp)[8 * i];
+        return intersect({{v[0], v[1]}, {v[2], v[3]}}, {{v[4], v[5]}, {v[6], v[7]}});
+    }
+
+    void get(uint i, double c[8]) const {
+        c[0] = x1[i];
+        c[1] = y1[i];
+        c[2] = x2[i];
+        c[3] = y2[i];
+        c[4] = x3[i];
+        c[5] = y3[i];
+        c[6] = x4[i];
+        c[7] = y4[i];
+    }
+
+#ifdef __AVX2__
+    void load4(uint i, __m256d c[8]) const {
+        c[0] = _mm256_loadu_pd(&x1[i]);
+        c[1] = _mm256_loadu_pd(&y1[i]);
+        c[2] = _mm256_loadu_pd(&x2[i]);
+        c[3] = _mm256_loadu_pd(&y2[i]);
+        c[4] = _mm256_loadu_pd(&x3[i]);
+        c[5] = _mm256_loadu_pd(&y3[i]);
+        c[6] = _mm256_loadu_pd(&x4[i]);
+        c[7] = _mm256_loadu_pd(&y4[i]);
+    }
+#endif
+};
+
+struct mapped_f64 {
+    const double* data;
+    uint n;
+
+    uint size() const {
+        return n;
+    }
+
+    bool skip(uint) const {
+        return false;
+    }
+
+    bool intersect_skipped(uint) const {
+        return false;
+    }
+
+    void get(uint i, double c[8]) const {
+        copy(data + 8 * i, data + 8 * i + 8, c);
+    }
+
+#ifdef __AVX2__
+    void load4(uint i, __m256d c[8]) const {
+        transpose4(data + 8 * i, c);
+        transpose4(data + 8 * i + 4, c + 4);
+    }
+#endif
+};
+
+struct mapped_i32 {
+    const int32_t* data;
+    uint n;
+
+    uint size() const {
+        return n;
+    }
+
+    bool skip(uint) const {
+        return false;
+    }
+
+    bool intersect_skipped(uint) const {
+        return false;
+    }
+
+    void get(uint i, double c[8]) const {
+        copy(data + 8 * i, data + 8 * i + 8, c);
+    }
+
+#ifdef __AVX2__
+    void load4(uint i, __m256d c[8]) const {
+        const __m128i idx = _mm_setr_epi32(0, 8, 16, 24);
+        for (int k = 0; k < 8; k++) {
+            c[k] = _mm256_cvtepi32_pd(_mm_i32gather_epi32(data + 8 * i + k, idx, 4));
+        }
+    }
+#endif
+};
+
+bool exact_double(long double v) {
+    return (long double) (double) v == v;
+}
+
+template <class F>
+void run_shards(uint n, uint threads, F f) {
+    uint words = (n + 63) / 64;
+    uint per = (words + threads - 1) / threads * 64;
+    if (threads <= 1 || per >= n) {
+        f(0, n);
+        return;
+    }
+    vector<thread> pool;
+    for (uint from = 0; from < n; from += per) {
+        pool.emplace_back(f, from, min(n, from + per));
+    }
+    for (thread& th : pool) {
+        th.join();
+    }
+}
+
+segment_batch make_batch(const vector<long double>& inp, uint threads = 1) {
+    segment_batch b;
+    uint n = inp.size() / 8;
+    vector<double>* cols[8] = {&b.x1, &b.y1, &b.x2, &b.y2, &b.x3, &b.y3, &b.x4, &b.y4};
+    for (auto c : cols) {
+        c->resize(n);
+    }
+    b.inexact.resize(n);
+    b.inp = &inp;
+    run_shards(n, threads, [&](uint from, uint to) {
+        for (uint i = from; i < to; i++) {
+            bool exact = true;
+            for (int k = 0; k < 8; k++) {
+                (*cols[k])[i] = inp[8 * i + k];
+                exact &= exact_double(inp[8 * i + k]);
+            }
+            b.inexact[i] = !exact;
+        }
+    });
+    return b;
+}
+
+bool resolve_pair(const double c[8], const int o[4]) {
+    segment seg1 = {{c[0], c[1]}, {c[2], c[3]}};
+    segment seg2 = {{c[4], c[5]}, {c[6], c[7]}};
+    int o1 = o[0] != 2 ? o[0] : orientation(seg1, seg2.p1);
+    int o2 = o[1] != 2 ? o[1] : orientation(seg1, seg2.p2);
+    int o3 = o[2] != 2 ? o[2] : orientation(seg2, seg1.p1);
+    int o4 = o[3] != 2 ? o[3] : orientation(seg2, seg1.p2);
+    return intersect(seg1, seg2, o1, o2, o3, o4);
+}
+
+template <class source>
+void intersect_batch(const source& src, uint from, uint to, uint64_t bits[]) {
+    uint i = from;
+#ifdef __AVX2__
+    for (; i + 4 <= to; i += 4) {
+        __m256d c[8];
+        src.load4(i, c);
+        int pos[4], neg[4];
+        orientation_filter4(c[0], c[1], c[2], c[3], c[4], c[5], pos[0], neg[0]);
+        orientation_filter4(c[0], c[1], c[2], c[3], c[6], c[7], pos[1], neg[1]);
+        orientation_filter4(c[4], c[5], c[6], c[7], c[0], c[1], pos[2], neg[2]);
+        orientation_filter4(c[4], c[5], c[6], c[7], c[2], c[3], pos[3], neg[3]);
+        for (int k = 0; k < 4; k++) {
+            if (src.skip(i + k)) {
+                bits[(i + k) >> 6] |= (uint64_t) src.intersect_skipped(i + k) << ((i + k) & 63);
+                continue;
+            }
+            int o[4];
+            bool sure = true;
+            for (int j = 0; j < 4; j++) {
+                o[j] = (pos[j] >> k & 1) ? 1 : (neg[j] >> k & 1) ? -1 : 2;
+                sure &= o[j] != 2;
+            }
+            bool res;
+            if (sure) {
+                res = o[0] != o[1] && o[2] != o[3];
+            } else {
+                double p[8];
+                src.get(i + k, p);
+                res = resolve_pair(p, o);
+            }
+            bits[(i + k) >> 6] |= (uint64_t) res << ((i + k) & 63);
+        }
+    }
+#endif
+    for (; i < to; i++) {
+        if (src.skip(i)) {
+            bits[i >> 6] |= (uint64_t) src.intersect_skipped(i) << (i & 63);
+            continue;
+        }
+        double c[8];
+        src.get(i, c);
+        int o[4] = {
+            orientation_filter(c[0], c[1], c[2], c[3], c[4], c[5]),
+            orientation_filter(c[0], c[1], c[2], c[3], c[6], c[7]),
+            orientation_filter(c[4], c[5], c[6], c[7], c[0], c[1]),
+            orientation_filter(c[4], c[5], c[6], c[7], c[2], c[3])
+        };
+        bits[i >> 6] |= (uint64_t) resolve_pair(c, o) << (i & 63);
+    }
+}
+
+template <class source>
+vector<uint64_t> intersect_parallel(const source& src, uint threads) {
+    vector<uint64_t> bits((src.size() + 63) / 64);
+    run_shards(src.size(), threads, [&](uint from, uint to) {
+        intersect_batch(src, from, to, bits.data());
+    });
+    return bits;
+}
+
+string intersect_batch(const segment_batch& b, uint threads = 1) {
+    vector<uint64_t> bits = intersect_parallel(b, threads);
+    string res(b.size(), 'N');
+    run_shards(b.size(), threads, [&](uint from, uint to) {
+        for (uint i = from; i < to; i++) {
+            if (bits[i >> 6] >> (i & 63) & 1) {
+                res[i] = 'Y';
+            }
+        }
+    });
+    return res;
+}
+
+template <class source>
+vector<uint64_t> intersect_mapped(const void* data, size_t bytes, uint threads) {
+    source src;
+    src.data = static_cast<decltype(src.data)>(data);
+    src.n = bytes / sizeof(*src.data) / 8;
+    return intersect_parallel(src, threads);
+}
+
+int run_mapped(const string& format, const char* path, uint threads) {
+    size_t record;
+    if (format == "f64") {
+        record = 64;
+    } else if (format == "i32") {
+        record = 32;
+    } else {
+        cerr << "unknown format " << format << "\n";
+        return 1;
+    }
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        cerr << "cannot open " << path << "\n";
+        return 1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        cerr << "cannot open " << path << "\n";
+        close(fd);
+        return 1;
+    }
+    size_t bytes = st.st_size;
+    if (bytes % record != 0) {
+        cerr << "ignoring " << bytes % record << " trailing bytes of " << path << "\n";
+    }
+    void* data = nullptr;
+    if (bytes > 0) {
+        data = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            cerr << "cannot map " << path << "\n";
+            close(fd);
+            return 1;
+        }
+        madvise(data, bytes, MADV_SEQUENTIAL);
+    }
+    size_t n = bytes / record;
+    vector<uint64_t> bits = record == 64 ? intersect_mapped<mapped_f64>(data, bytes, threads)
+                                         : intersect_mapped<mapped_i32>(data, bytes, threads);
+    if (data != nullptr) {
+        munmap(data, bytes);
+    }
+    close(fd);
+    const char* out = (const char*) bits.data();
+    size_t left = (n + 7) / 8;
+    while (left > 0) {
+        ssize_t w = write(1, out, left);
+        if (w <= 0) {
+            return 1;
+        }
+        out += w;
+        left -= w;
+    }
+    return 0;
+}
+
+string intersect_scalar(const vector<long double>& inp) {
+    string res;
+    res.reserve(inp.size() / 8);
+    for (uint i = 0; i < inp.size(); i += 8) {
+        point p1 = {inp[i], inp[i + 1]};
+        point p2 = {inp[i + 2], inp[i + 3]};
+        point p3 = {inp[i + 4], inp[i + 5]};
+        point p4 = {inp[i + 6], inp[i + 7]};
+        res += intersect({p1, p2}, {p3, p4}) ? 'Y' : 'N';
+    }
+    return res;
+}
+
+void bench(const vector<long double>& inp) {
+    using clock = chrono::steady_clock;
+    uint n = inp.size() / 8;
+    auto t0 = clock::now();
+    string scalar = intersect_scalar(inp);
+    auto t1 = clock::now();
+    segment_batch b = make_batch(inp);
+    auto t2 = clock::now();
+    string batch = intersect_batch(b);
+    auto t3 = clock::now();
+    uint diff = 0;
+    for (uint i = 0; i < n; i++) {
+        diff += scalar[i] != batch[i];
+    }
+    double ts = chrono::duration<double>(t1 - t0).count();
+    double tl = chrono::duration<double>(t2 - t1).count();
+    double tb = chrono::duration<double>(t3 - t2).count();
+    cout << "pairs " << n << "\n";
+    cout << "scalar " << n / ts << " pairs/s\n";
+    cout << "batch " << n / tb << " pairs/s (layout " << n / tl << " pairs/s)\n";
+    cout << "scalar-path pairs " << count(b.inexact.begin(), b.inexact.end(), 1) << ", mismatches " << diff << "\n";
+}
+
+void bench_scaling(const vector<long double>& inp, uint max_threads) {
+    using clock = chrono::steady_clock;
+    uint n = inp.size() / 8;
+    string expected;
+    cout << "pairs " << n << "\n";
+    for (uint threads = 1; threads <= max_threads; threads++) {
+        auto t0 = clock::now();
+        segment_batch b = make_batch(inp, threads);
+        string res = intersect_batch(b, threads);
+        auto t1 = clock::now();
+        if (threads == 1) {
+            expected = res;
+        }
+        double tt = chrono::duration<double>(t1 - t0).count();
+        cout << "threads " << threads << " " << n / tt << " pairs/s" << (res == expected ? "" : " MISMATCH") << "\n";
+    }
+}
+
+uint thread_count(int argc, char* argv[], int index) {
+    if (argc > index) {
+        return max(1, atoi(argv[index]));
+    }
+    return max(1u, thread::hardware_concurrency());
+}
+
+int main(int argc, char* argv[]) {
+    string mode = argc > 1 ? argv[1] : "";
+    if (mode == "mmap" && argc > 3) {
+        return run_mapped(argv[2], argv[3], thread_count(argc, argv, 4));
+    }
     int t;
     cin >> t;
     auto inp = genTest(t);
+    if (mode == "bench") {
+        bench(inp);
+        return 0;
+    }
+    if (mode == "scale") {
+        bench_scaling(inp, thread_count(argc, argv, 2));
+        return 0;
+    }
+    if (mode == "batch" || mode == "parallel") {
+        uint threads = mode == "parallel" ? thread_count(argc, argv, 2) : 1;
+        cout << intersect_batch(make_batch(inp, threads), threads) << "\n";
+        return 0;
+    }
     for (uint i = 0; i < inp.size(); i += 8) {
         point p1 = {inp[i], inp[i + 1]};
         point p2 = {inp[i + 2], inp[i + 3]};
@@ -53,23 +641,10 @@ int main() {
         point p4 = {inp[i + 6], inp[i + 7]};
         segment seg1 = { p1, p2 };
         segment seg2 = { p3, p4 };
-        int o1 = orientation(seg1, p3);
-        int o2 = orientation(seg1, p4);
-        int o3 = orientation(seg2, p1);
-        int o4 = orientation(seg2, p2);
-        bool pr1 = o1 != o2;
-        bool pr2 = o3 != o4;
-
-        if (pr1 & pr2) {
+        if (intersect(seg1, seg2)) {
             cout << "Y";
-        } else if (!pr1 && o1 != 0 || !pr2 && o3 != 0) {
-            cout << "N";
         } else {
-            if (between(seg1, p3) || between(seg1, p4) || between(seg2, p1) || between(seg2, p2)) {
-                cout << "Y";
-            } else {
-                cout << "N";
-            }
+            cout << "N";
         }
     }
     cout << "\n";
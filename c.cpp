@@ -2,6 +2,16 @@
 #include <algorithm>
 #include <limits>
 #include <cmath>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#ifdef _OPENMP
+#include <parallel/algorithm>
+#define OMP_PRAGMA(x) _Pragma(#x)
+#else
+#define OMP_PRAGMA(x)
+#endif
 
 using namespace std;
 
@@ -10,9 +20,82 @@ struct point {
     long long y;
 };
 
-long double min_len = numeric_limits<long double>::max();
-unsigned long long min_len_sqr = numeric_limits<unsigned long long>::max();
-point p1, p2;
+struct closest_pair_result {
+    point p1;
+    point p2;
+    unsigned long long len_sqr;
+};
+
+struct closest_pair_state {
+    point* buf;
+    point* strip_buf;
+    long double min_len;
+    closest_pair_result best;
+
+    long double width() const {
+        return min_len;
+    }
+
+    void visit(const point& a, const point& b, unsigned long long len) {
+        if (len < best.len_sqr) {
+            best = {a, b, len};
+            min_len = sqrt(len);
+        }
+    }
+};
+
+template <class F>
+struct radius_pairs {
+    point* buf;
+    point* strip_buf;
+    unsigned long long radius_sqr;
+    long double strip;
+    F out;
+
+    long double width() const {
+        return strip;
+    }
+
+    void visit(const point& a, const point& b, unsigned long long len) {
+        if (len <= radius_sqr) {
+            out(a, b, len);
+        }
+    }
+};
+
+struct pair_len_comp {
+    bool operator ()(const closest_pair_result& a, const closest_pair_result& b) const {
+        return a.len_sqr < b.len_sqr;
+    }
+};
+
+struct k_closest_pairs {
+    point* buf;
+    point* strip_buf;
+    size_t k;
+    long double strip;
+    vector<closest_pair_result> heap;
+
+    long double width() const {
+        return strip;
+    }
+
+    void visit(const point& a, const point& b, unsigned long long len) {
+        if (heap.size() < k) {
+            heap.push_back({a, b, len});
+            push_heap(heap.begin(), heap.end(), pair_len_comp());
+        } else if (k > 0 && len < heap.front().len_sqr) {
+            pop_heap(heap.begin(), heap.end(), pair_len_comp());
+            heap.back() = {a, b, len};
+            push_heap(heap.begin(), heap.end(), pair_len_comp());
+        } else {
+            return;
+        }
+        if (heap.size() == k) {
+            strip = sqrt(heap.front().len_sqr);
+        }
+    }
+};
 
 struct points_comp {
     bool operator ()(const point& a, const point& b) {
@@ -30,42 +113,37 @@ inline unsigned long long sqr(long long x) {
     return x * x;
 }
 points_comp_y comp_y;
-void rec(point points[], unsigned int l, unsigned int r) {
-    if (r - l <= 4) {
-        for (unsigned int i = l; i < r; i++) {
-            for (unsigned int j = i + 1; j < r; j++) {
-                unsigned long long len = sqr(points[i].x - points[j].x) + sqr(points[i].y - points[j].y);
-                if (len < min_len_sqr) {
-                    p1 = points[i];
-                    p2 = points[j];
-                    min_len_sqr = len;
-                }
-            }
+// Copies the right half's points closer than the strip width to the split
+// line into st.strip_buf[m, end), still ordered by y, and returns end. The width
+// only shrinks during a merge, so filtering with its current value is safe.
+template <class visitor>
+unsigned int right_strip(const point points[], unsigned int m, unsigned int r, long long m_x, visitor& st) {
+    unsigned int end = m;
+    for (unsigned int i = m; i < r; i++) {
+        if (points[i].x - m_x < st.width()) {
+            st.strip_buf[end++] = points[i];
         }
-        min_len = sqrt(min_len_sqr);
-        sort(points + l, points + r, comp_y);
-        return;
     }
-    unsigned int m = (l + r) / 2;
-    long long m_x = points[m].x;
-    rec(points, l, m);
-    rec(points, m, r);
-    unsigned int sz = r - l;
-    point res[sz];
-    unsigned int i = l;
-    unsigned int j = m;
-    for (int k = 0; i < m || j < r; k++) {
+    return end;
+}
+
+template <class visitor>
+void merge_strip(point points[], unsigned int m, unsigned int r, long long m_x, unsigned int strip_end,
+                 unsigned int i, unsigned int j, unsigned int k, unsigned int k_end, visitor& st) {
+    point* res = st.buf;
+    const point* strip = st.strip_buf;
+    for (; k < k_end; k++) {
         if (i != m && (j == r || points[i].y <= points[j].y)) {
-            if (m_x - points[i].x < min_len) {
+            if (m_x - points[i].x < st.width()) {
 //                unsigned int bottom = m;
 //                while (bottom < r && points[i].y - points[bottom].y >= min_len) {
 //                    bottom++;
 //                }
                 unsigned int l1 = m - 1;
-                unsigned int r1 = r;
+                unsigned int r1 = strip_end;
                 while (l1 < r1 - 1) {
                     unsigned int m1 = (l1 + r1) / 2;
-                    if (points[i].y - points[m1].y >= min_len) {
+                    if (points[i].y - strip[m1].y >= st.width()) {
                         l1 = m1;
                     } else {
                         r1 = m1;
@@ -78,10 +156,10 @@ void rec(point points[], unsigned int l, unsigned int r) {
 //                }
 
                 l1 = bottom - 1;
-                r1 = r;
+                r1 = strip_end;
                 while (l1 < r1 - 1) {
                     unsigned int m1 = (l1 + r1) / 2;
-                    if (points[m1].y - points[i].y < min_len) {
+                    if (strip[m1].y - points[i].y < st.width()) {
                         l1 = m1;
                     } else {
                         r1 = m1;
@@ -89,14 +167,9 @@ void rec(point points[], unsigned int l, unsigned int r) {
                 }
                 unsigned int top = r1;
                 for (unsigned int i1 = bottom; i1 < top; i1++) {
-                    unsigned long long len = sqr(points[i].x - points[i1].x) + sqr(points[i].y - points[i1].y);
-                    if (len < min_len_sqr) {
-                        p1 = points[i];
-                        p2 = points[i1];
-                        min_len_sqr = len;
-                    }
+                    unsigned long long len = sqr(points[i].x - strip[i1].x) + sqr(points[i].y - strip[i1].y);
+                    st.visit(points[i], strip[i1], len);
                 }
-                min_len = sqrt(min_len_sqr);
             }
             res[k] = points[i];
             i++;
@@ -105,23 +178,360 @@ void rec(point points[], unsigned int l, unsigned int r) {
             j++;
         }
     }
-    copy(res, res + sz, points + l);
 }
 
-int main() {
+template <class visitor>
+void rec(point points[], unsigned int l, unsigned int r, visitor& st) {
+    if (r - l <= 4) {
+        for (unsigned int i = l; i < r; i++) {
+            for (unsigned int j = i + 1; j < r; j++) {
+                unsigned long long len = sqr(points[i].x - points[j].x) + sqr(points[i].y - points[j].y);
+                st.visit(points[i], points[j], len);
+            }
+        }
+        sort(points + l, points + r, comp_y);
+        return;
+    }
+    unsigned int m = (l + r) / 2;
+    long long m_x = points[m].x;
+    rec(points, l, m, st);
+    rec(points, m, r, st);
+    merge_strip(points, m, r, m_x, right_strip(points, m, r, m_x, st), l, m, l, r, st);
+    copy(st.buf + l, st.buf + r, points + l);
+}
+
+const unsigned int fork_cutoff = 1 << 14;
+const unsigned int merge_chunk = 1 << 16;
+
+unsigned int co_rank(const point points[], unsigned int l, unsigned int m, unsigned int r, unsigned int k) {
+    unsigned int lo = k > r - m ? k - (r - m) : 0;
+    unsigned int hi = min(k, m - l);
+    while (lo < hi) {
+        unsigned int i = (lo + hi) / 2;
+        unsigned int j = k - i;
+        if (points[m + j - 1].y >= points[l + i].y) {
+            lo = i + 1;
+        } else {
+            hi = i;
+        }
+    }
+    return l + lo;
+}
+
+void take_best(closest_pair_state& st, const closest_pair_state& other) {
+    if (other.best.len_sqr < st.best.len_sqr) {
+        st.best = other.best;
+        st.min_len = other.min_len;
+    }
+}
+
+void merge_parallel(point points[], unsigned int l, unsigned int m, unsigned int r, long long m_x, closest_pair_state& st) {
+    unsigned int chunks = (r - l + merge_chunk - 1) / merge_chunk;
+    unsigned int strip_end = right_strip(points, m, r, m_x, st);
+    vector<closest_pair_state> parts(chunks, st);
+    for (unsigned int c = 0; c < chunks; c++) {
+        OMP_PRAGMA(omp task shared(parts))
+        {
+            unsigned int k = l + c * merge_chunk;
+            unsigned int k_end = min(r, k + merge_chunk);
+            unsigned int i = co_rank(points, l, m, r, k - l);
+            unsigned int j = m + (k - l) - (i - l);
+            merge_strip(points, m, r, m_x, strip_end, i, j, k, k_end, parts[c]);
+        }
+    }
+    OMP_PRAGMA(omp taskwait)
+    for (const closest_pair_state& part : parts) {
+        take_best(st, part);
+    }
+    for (unsigned int c = 0; c < chunks; c++) {
+        OMP_PRAGMA(omp task)
+        {
+            unsigned int k = l + c * merge_chunk;
+            copy(st.buf + k, st.buf + min(r, k + merge_chunk), points + k);
+        }
+    }
+    OMP_PRAGMA(omp taskwait)
+}
+
+void rec_parallel(point points[], unsigned int l, unsigned int r, closest_pair_state& st) {
+    if (r - l < fork_cutoff) {
+        rec(points, l, r, st);
+        return;
+    }
+    unsigned int m = (l + r) / 2;
+    long long m_x = points[m].x;
+    closest_pair_state left = st;
+    closest_pair_state right = st;
+    OMP_PRAGMA(omp task shared(left))
+    rec_parallel(points, l, m, left);
+    rec_parallel(points, m, r, right);
+    OMP_PRAGMA(omp taskwait)
+    take_best(st, left);
+    take_best(st, right);
+    if (r - l >= 2 * merge_chunk) {
+        merge_parallel(points, l, m, r, m_x, st);
+    } else {
+        merge_strip(points, m, r, m_x, right_strip(points, m, r, m_x, st), l, m, l, r, st);
+        copy(st.buf + l, st.buf + r, points + l);
+    }
+}
+
+template <class visitor>
+void visit_close_pairs(vector<point>& points, visitor& st) {
+    vector<point> buf(points.size());
+    vector<point> strip(points.size());
+    st.buf = buf.data();
+    st.strip_buf = strip.data();
+    points_comp points_x_comp;
+    sort(points.begin(), points.end(), points_x_comp);
+    rec(points.data(), 0, points.size(), st);
+    st.buf = nullptr;
+    st.strip_buf = nullptr;
+}
+
+template <class F>
+void radius_pairs_stream(vector<point>& points, long double radius, F out) {
+    const unsigned long long max_sqr = numeric_limits<unsigned long long>::max();
+    unsigned long long radius_sqr = radius * radius >= (long double) max_sqr ? max_sqr : floor(radius * radius);
+    unsigned long long s = min(floor(sqrt((long double) radius_sqr)), (long double) 0xffffffffULL);
+    while (s * s > radius_sqr) {
+        s--;
+    }
+    while (s < 0xffffffffULL && (s + 1) * (s + 1) <= radius_sqr) {
+        s++;
+    }
+    radius_pairs<F> st = {nullptr, nullptr, radius_sqr, (long double) s + 1, out};
+    visit_close_pairs(points, st);
+}
+
+vector<closest_pair_result> k_closest(vector<point>& points, size_t k) {
+    k_closest_pairs st = {nullptr, nullptr, k, numeric_limits<long double>::max(), {}};
+    visit_close_pairs(points, st);
+    sort_heap(st.heap.begin(), st.heap.end(), pair_len_comp());
+    return st.heap;
+}
+
+closest_pair_result closest_pair(vector<point>& points, bool parallel = false) {
+    closest_pair_state st = {nullptr, nullptr, numeric_limits<long double>::max(),
+                             {{0, 0}, {0, 0}, numeric_limits<unsigned long long>::max()}};
+    if (!parallel) {
+        visit_close_pairs(points, st);
+        return st.best;
+    }
+    vector<point> buf(points.size());
+    vector<point> strip(points.size());
+    st.buf = buf.data();
+    st.strip_buf = strip.data();
+    points_comp points_x_comp;
+#ifdef _OPENMP
+    __gnu_parallel::sort(points.begin(), points.end(), points_x_comp);
+#else
+    sort(points.begin(), points.end(), points_x_comp);
+#endif
+    OMP_PRAGMA(omp parallel)
+    OMP_PRAGMA(omp single)
+    rec_parallel(points.data(), 0, points.size(), st);
+    return st.best;
+}
+
+struct grid_cell {
+    unsigned long long key;
+    int head;
+};
+
+struct point_grid {
+    vector<grid_cell> table;
+    vector<unsigned long long> filter;
+    vector<int> used;
+    vector<int> next;
+    unsigned long long mask;
+    long long min_x, min_y;
+    unsigned long long cell;
+
+    point_grid(unsigned int n, long long min_x, long long min_y) : next(n), min_x(min_x), min_y(min_y) {
+        unsigned long long sz = 64;
+        while (sz < 2ULL * n) {
+            sz *= 2;
+        }
+        table.assign(sz, {0, -1});
+        filter.assign(sz / 64, 0);
+        mask = sz - 1;
+    }
+
+    static unsigned long long mix(unsigned long long h) {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        return h ^ (h >> 33);
+    }
+
+    unsigned long long cell_x(const point& p) const {
+        return (unsigned long long) (p.x - min_x) / cell;
+    }
+
+    unsigned long long cell_y(const point& p) const {
+        return (unsigned long long) (p.y - min_y) / cell;
+    }
+
+    static unsigned long long cell_key(unsigned long long cx, unsigned long long cy) {
+        return cx * 0x9e3779b97f4a7c15ULL + cy;
+    }
+
+    bool maybe_used(unsigned long long h) const {
+        unsigned long long bit = h >> 2 & mask;
+        return filter[bit >> 6] >> (bit & 63) & 1;
+    }
+
+    int find(unsigned long long key) const {
+        unsigned long long h = mix(key);
+        if (!maybe_used(h)) {
+            return -1;
+        }
+        for (h &= mask; table[h].head != -1; h = (h + 1) & mask) {
+            if (table[h].key == key) {
+                return table[h].head;
+            }
+        }
+        return -1;
+    }
+
+    void insert(const point points[], int i) {
+        unsigned long long key = cell_key(cell_x(points[i]), cell_y(points[i]));
+        unsigned long long h = mix(key);
+        unsigned long long bit = h >> 2 & mask;
+        filter[bit >> 6] |= 1ULL << (bit & 63);
+        for (h &= mask; table[h].head != -1 && table[h].key != key; h = (h + 1) & mask) {
+        }
+        if (table[h].head == -1) {
+            table[h].key = key;
+            used.push_back(h);
+        }
+        next[i] = table[h].head;
+        table[h].head = i;
+    }
+
+    void rebuild(const point points[], int n, unsigned long long len_sqr) {
+        unsigned long long new_cell = max(1.0L, floor(sqrt((long double) len_sqr)));
+        while (new_cell * new_cell < len_sqr) {
+            new_cell++;
+        }
+        new_cell *= 2;
+        for (int h : used) {
+            table[h].head = -1;
+        }
+        used.clear();
+        fill(filter.begin(), filter.end(), 0);
+        cell = new_cell;
+        for (int i = 0; i < n; i++) {
+            insert(points, i);
+        }
+    }
+};
+
+closest_pair_result closest_pair_grid(vector<point> points, unsigned long long seed) {
+    closest_pair_result best = {{0, 0}, {0, 0}, numeric_limits<unsigned long long>::max()};
+    int n = points.size();
+    if (n < 2) {
+        return best;
+    }
+    mt19937_64 rng(seed);
+    shuffle(points.begin(), points.end(), rng);
+    long long min_x = points[0].x;
+    long long min_y = points[0].y;
+    for (const point& p : points) {
+        min_x = min(min_x, p.x);
+        min_y = min(min_y, p.y);
+    }
+    best = {points[0], points[1], sqr(points[0].x - points[1].x) + sqr(points[0].y - points[1].y)};
+    point_grid grid(n, min_x, min_y);
+    grid.rebuild(points.data(), 2, best.len_sqr);
+    for (int i = 2; i < n && best.len_sqr > 0; i++) {
+        bool closer = false;
+        unsigned long long cx = grid.cell_x(points[i]);
+        unsigned long long cy = grid.cell_y(points[i]);
+        unsigned long long nx = (points[i].x - grid.min_x) - cx * grid.cell < grid.cell / 2 ? cx - 1 : cx + 1;
+        unsigned long long ny = (points[i].y - grid.min_y) - cy * grid.cell < grid.cell / 2 ? cy - 1 : cy + 1;
+        for (unsigned long long x : {cx, nx}) {
+            for (unsigned long long y : {cy, ny}) {
+                for (int j = grid.find(point_grid::cell_key(x, y)); j != -1; j = grid.next[j]) {
+                    unsigned long long len = sqr(points[i].x - points[j].x) + sqr(points[i].y - points[j].y);
+                    if (len < best.len_sqr) {
+                        best = {points[j], points[i], len};
+                        closer = true;
+                    }
+                }
+            }
+        }
+        if (closer) {
+            grid.rebuild(points.data(), i + 1, best.len_sqr);
+        } else {
+            grid.insert(points.data(), i);
+        }
+    }
+    return best;
+}
+
+void bench(const vector<point>& points) {
+    using clock = chrono::steady_clock;
+    vector<point> copy_points = points;
+    auto t0 = clock::now();
+    closest_pair_result dc = closest_pair(copy_points);
+    auto t1 = clock::now();
+    closest_pair_result grid = closest_pair_grid(points, random_device()());
+    auto t2 = clock::now();
+    cout << "divide and conquer " << chrono::duration<double>(t1 - t0).count() << " s, len^2 " << dc.len_sqr << '\n';
+    cout << "grid " << chrono::duration<double>(t2 - t1).count() << " s, len^2 " << grid.len_sqr << '\n';
+}
+
+int main(int argc, char* argv[]) {
+    string mode = argc > 1 ? argv[1] : "";
+    bool parallel = mode == "parallel";
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
     int n;
     cin >> n;
-    point points[n];
+    vector<point> points(n);
     for (int i = 0; i < n; i++) {
         long long x, y;
         cin >> x >> y;
         points[i] = {x, y};
     }
-    points_comp points_x_comp;
-    sort(points, points + n, points_x_comp);
-    rec(points, 0, n);
-    cout << p1.x << " " << p1.y << '\n';
-    cout << p2.x << " " << p2.y << '\n';
+    if (mode == "bench") {
+        bench(points);
+        return 0;
+    }
+    if (mode == "radius" && argc > 2) {
+        long double radius = stold(argv[2]);
+        if (!isfinite(radius) || radius < 0) {
+            cerr << "radius must be finite and non-negative" << endl;
+            return 1;
+        }
+        // No pair is further apart than the bounding box diagonal.
+        long double span = 0;
+        if (n > 0) {
+            auto [lo_x, hi_x] = minmax_element(points.begin(), points.end(), [](const point& a, const point& b) {
+                return a.x < b.x;
+            });
+            auto [lo_y, hi_y] = minmax_element(points.begin(), points.end(), [](const point& a, const point& b) {
+                return a.y < b.y;
+            });
+            span = hypotl(hi_x->x - lo_x->x, hi_y->y - lo_y->y);
+        }
+        radius = min(radius, span + 1);
+        radius_pairs_stream(points, radius, [](const point& a, const point& b, unsigned long long) {
+            cout << a.x << " " << a.y << " " << b.x << " " << b.y << '\n';
+        });
+        return 0;
+    }
+    if (mode == "kclosest" && argc > 2) {
+        for (const closest_pair_result& p : k_closest(points, stoull(argv[2]))) {
+            cout << p.p1.x << " " << p.p1.y << " " << p.p2.x << " " << p.p2.y << '\n';
+        }
+        return 0;
+    }
+    closest_pair_result res = mode == "grid" ? closest_pair_grid(points, random_device()())
+                                             : closest_pair(points, parallel);
+    cout << res.p1.x << " " << res.p1.y << '\n';
+    cout << res.p2.x << " " << res.p2.y << '\n';
 }
\ No newline at end of file
@@ -1,6 +1,11 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <cstdlib>
+#include <cmath>
 
 using namespace std;
 
@@ -86,7 +91,199 @@ bool in_polygon(polygon& a, point& p) {
     return orientation({a.points[l], a.points[r]}, p) == 0 || !intersect(a.points[0], p, a.points[l], a.points[r]);
 }
 
-int main() {
+struct polygon_fan {
+    vector<point> rays;
+    vector<point> edges;
+};
+
+polygon_fan make_fan(const polygon& a) {
+    polygon_fan f;
+    int n = a.points.size();
+    f.rays.resize(n);
+    f.edges.resize(n);
+    for (int i = 0; i < n; i++) {
+        f.rays[i] = vec({a.points[0], a.points[i]});
+        f.edges[i] = vec({a.points[i], a.points[(i + 1) % n]});
+    }
+    return f;
+}
+
+struct fan_angle_comp {
+    point base;
+
+    bool operator ()(const point& a, const point& b) const {
+        bool ha = pseudovec(base, a) == 0 && a.x * base.x + a.y * base.y < 0;
+        bool hb = pseudovec(base, b) == 0 && b.x * base.x + b.y * base.y < 0;
+        if (ha != hb) {
+            return hb;
+        }
+        return pseudovec(a, b) > 0;
+    }
+};
+
+struct polygon_index {
+    polygon_fan fan;
+    point origin;
+    long double t_lo;
+    long double scale;
+    vector<int> lo;
+    vector<int> hi;
+};
+
+long double pseudo_angle(const point& d) {
+    return d.y / ((long double) llabs(d.x) + llabs(d.y));
+}
+
+int angle_bucket(const polygon_index& idx, long double t) {
+    long double b = (t - idx.t_lo) * idx.scale;
+    int buckets = idx.lo.size();
+    if (!(b > 0)) {
+        return 0;
+    }
+    return b >= buckets ? buckets - 1 : (int) b;
+}
+
+polygon_index make_index(const polygon& a) {
+    polygon_index idx;
+    idx.fan = make_fan(a);
+    idx.origin = a.points[0];
+    int n = a.points.size();
+    idx.t_lo = pseudo_angle(idx.fan.rays[1]);
+    long double t_hi = pseudo_angle(idx.fan.rays[n - 1]);
+    idx.scale = t_hi > idx.t_lo ? n / (t_hi - idx.t_lo) : 0;
+    idx.lo.assign(n, n - 2);
+    idx.hi.assign(n, 1);
+    for (int j = 1; j <= n - 2; j++) {
+        int b1 = angle_bucket(idx, pseudo_angle(idx.fan.rays[j]));
+        int b2 = angle_bucket(idx, pseudo_angle(idx.fan.rays[j + 1]));
+        for (int b = min(b1, b2); b <= max(b1, b2); b++) {
+            idx.lo[b] = min(idx.lo[b], j);
+            idx.hi[b] = max(idx.hi[b], j);
+        }
+    }
+    return idx;
+}
+
+bool in_polygon(const polygon_index& idx, const point& p) {
+    const vector<point>& rays = idx.fan.rays;
+    int n = rays.size();
+    point d = vec({idx.origin, p});
+    if (d.x == 0 && d.y == 0) {
+        return true;
+    }
+    if (pseudovec(rays[1], d) < 0 || pseudovec(rays[n - 1], d) > 0) {
+        return false;
+    }
+    int b = angle_bucket(idx, pseudo_angle(d));
+    int l = idx.lo[b];
+    int r = idx.hi[b];
+    if (l > r || pseudovec(rays[l], d) < 0 || (r < n - 2 && pseudovec(rays[r + 1], d) >= 0)) {
+        l = 1;
+        r = n - 2;
+    }
+    while (l < r) {
+        int m = (l + r + 1) / 2;
+        if (pseudovec(rays[m], d) >= 0) {
+            l = m;
+        } else {
+            r = m - 1;
+        }
+    }
+    return pseudovec(idx.fan.edges[l], vec({rays[l], d})) >= 0;
+}
+
+const int query_block = 1 << 16;
+
+int count_block(const polygon_fan& f, const vector<point>& points, const point& origin,
+                int from, int to, vector<point>& buf) {
+    int n = f.rays.size();
+    int count = 0;
+    buf.clear();
+    for (int i = from; i < to; i++) {
+        point d = vec({origin, points[i]});
+        if (d.x == 0 && d.y == 0) {
+            count++;
+        } else if (pseudovec(f.rays[1], d) >= 0 && pseudovec(f.rays[n - 1], d) <= 0) {
+            buf.push_back(d);
+        }
+    }
+    if (buf.empty()) {
+        return count;
+    }
+    sort(buf.begin(), buf.end(), fan_angle_comp{f.rays[1]});
+    int w = 1;
+    for (const point& d : buf) {
+        int step = 1;
+        while (w + step <= n - 2 && pseudovec(f.rays[w + step], d) >= 0) {
+            w += step;
+            step *= 2;
+        }
+        while (step > 1) {
+            step /= 2;
+            if (w + step <= n - 2 && pseudovec(f.rays[w + step], d) >= 0) {
+                w += step;
+            }
+        }
+        count += pseudovec(f.edges[w], vec({f.rays[w], d})) >= 0;
+    }
+    return count;
+}
+
+bool count_at_least(const polygon& a, const vector<point>& points, int k, unsigned int threads) {
+    int m = points.size();
+    if (k <= 0) {
+        return true;
+    }
+    if (k > m) {
+        return false;
+    }
+    if (a.points.size() < 3) {
+        int count = 0;
+        for (point p : points) {
+            polygon b = a;
+            count += in_polygon(b, p);
+        }
+        return count >= k;
+    }
+    polygon_fan f = make_fan(a);
+    atomic<int> next(0);
+    atomic<int> inside(0);
+    atomic<bool> decided(false);
+    auto work = [&]() {
+        vector<point> buf;
+        buf.reserve(query_block);
+        while (!decided.load(memory_order_relaxed)) {
+            int from = next.fetch_add(query_block);
+            if (from >= m) {
+                break;
+            }
+            int to = min(m, from + query_block);
+            int got = count_block(f, points, a.points[0], from, to, buf);
+            if (inside.fetch_add(got) + got >= k) {
+                decided.store(true, memory_order_relaxed);
+            }
+        }
+    };
+    vector<thread> pool;
+    for (unsigned int t = 1; t < threads; t++) {
+        pool.emplace_back(work);
+    }
+    work();
+    for (thread& th : pool) {
+        th.join();
+    }
+    return inside.load() >= k;
+}
+
+unsigned int thread_count(int argc, char* argv[], int index) {
+    if (argc > index) {
+        return max(1, atoi(argv[index]));
+    }
+    return max(1u, thread::hardware_concurrency());
+}
+
+int main(int argc, char* argv[]) {
+    string mode = argc > 1 ? argv[1] : "";
     int n, m, k;
     cin >> n >> m >> k;
     polygon poly;
@@ -109,9 +306,20 @@ int main() {
         cin >> x >> y;
         points[i] = { x, y };
     }
+    if (mode == "batch") {
+        cout << (count_at_least(poly, points, k, thread_count(argc, argv, 2)) ? "YES" : "NO") << endl;
+        return 0;
+    }
     int count = 0;
-    for (int i = 0; i < m; i++) {
-        count += in_polygon(poly, points[i]);
+    if (n >= 3) {
+        polygon_index idx = make_index(poly);
+        for (int i = 0; i < m; i++) {
+            count += in_polygon(idx, points[i]);
+        }
+    } else {
+        for (int i = 0; i < m; i++) {
+            count += in_polygon(poly, points[i]);
+        }
     }
     if (count < k) {
         cout << "NO" << endl;
@@ -1,6 +1,15 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <ext/pb_ds/assoc_container.hpp>
+#include <ext/pb_ds/tree_policy.hpp>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 using namespace std;
 
@@ -92,7 +101,467 @@ bool in_polygon(polygon& a, point& p, point& m) {
     return intersectCount & 1;
 }
 
-int main() {
+bool point_less(const point& a, const point& b) {
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+// Both edges are directed left to right and share an open x-range; simple
+// polygon edges never cross, so comparing one endpoint (or, when that
+// endpoint is shared, the other one) against the other edge's line decides.
+bool edge_below(const segment& e, const segment& f) {
+    if (e.p1.x >= f.p1.x) {
+        int o = orientation(f, e.p1);
+        if (o == 0) {
+            o = orientation(f, e.p2);
+        }
+        return o < 0;
+    }
+    int o = orientation(e, f.p1);
+    if (o == 0) {
+        o = orientation(e, f.p2);
+    }
+    return o > 0;
+}
+
+struct slab_node {
+    int edge;
+    int left;
+    int right;
+    int size;
+    unsigned int prio;
+};
+
+// Slab decomposition over the distinct vertex x-coordinates. roots[i] is a
+// persistent treap of the non-vertical edges spanning [xs[i], xs[i + 1]),
+// ordered bottom to top; consecutive versions share all untouched nodes.
+struct slab_index {
+    vector<long long> xs;
+    vector<int> roots;
+    vector<segment> edges;
+    vector<slab_node> nodes;
+    vector<point> vertices;
+    vector<segment> verticals;
+    mt19937 rnd;
+};
+
+int copy_node(slab_index& s, int t) {
+    s.nodes.push_back(s.nodes[t]);
+    return s.nodes.size() - 1;
+}
+
+void update(slab_index& s, int t) {
+    s.nodes[t].size = 1 + s.nodes[s.nodes[t].left].size + s.nodes[s.nodes[t].right].size;
+}
+
+int merge(slab_index& s, int l, int r) {
+    if (!l || !r) {
+        return l ? l : r;
+    }
+    if (s.nodes[l].prio > s.nodes[r].prio) {
+        int t = copy_node(s, l);
+        int right = merge(s, s.nodes[l].right, r);
+        s.nodes[t].right = right;
+        update(s, t);
+        return t;
+    }
+    int t = copy_node(s, r);
+    int left = merge(s, l, s.nodes[r].left);
+    s.nodes[t].left = left;
+    update(s, t);
+    return t;
+}
+
+void split(slab_index& s, int t, int e, int& l, int& r) {
+    if (!t) {
+        l = r = 0;
+        return;
+    }
+    int c = copy_node(s, t);
+    int a, b;
+    if (edge_below(s.edges[s.nodes[t].edge], s.edges[e])) {
+        split(s, s.nodes[t].right, e, a, b);
+        s.nodes[c].right = a;
+        update(s, c);
+        l = c;
+        r = b;
+    } else {
+        split(s, s.nodes[t].left, e, a, b);
+        s.nodes[c].left = b;
+        update(s, c);
+        l = a;
+        r = c;
+    }
+}
+
+int insert(slab_index& s, int t, int e) {
+    int l, r;
+    split(s, t, e, l, r);
+    s.nodes.push_back({e, 0, 0, 1, (unsigned int) s.rnd()});
+    int leaf = s.nodes.size() - 1;
+    return merge(s, merge(s, l, leaf), r);
+}
+
+int erase(slab_index& s, int t, int e) {
+    if (s.nodes[t].edge == e) {
+        return merge(s, s.nodes[t].left, s.nodes[t].right);
+    }
+    int c = copy_node(s, t);
+    if (edge_below(s.edges[e], s.edges[s.nodes[t].edge])) {
+        int left = erase(s, s.nodes[t].left, e);
+        s.nodes[c].left = left;
+    } else {
+        int right = erase(s, s.nodes[t].right, e);
+        s.nodes[c].right = right;
+    }
+    update(s, c);
+    return c;
+}
+
+// Directs every edge left to right (bottom to top when vertical) and keeps
+// vertical edges and vertices apart, sorted, for exact boundary lookups.
+void split_edges(const polygon& a, vector<segment>& edges, vector<segment>& verticals, vector<point>& vertices) {
+    int n = a.points.size();
+    vertices = a.points;
+    sort(vertices.begin(), vertices.end(), point_less);
+    for (int i = 0; i < n; i++) {
+        point p1 = a.points[i];
+        point p2 = a.points[(i + 1) % n];
+        if (point_less(p2, p1)) {
+            swap(p1, p2);
+        }
+        if (p1.x == p2.x) {
+            verticals.push_back({p1, p2});
+        } else {
+            edges.push_back({p1, p2});
+        }
+    }
+    sort(verticals.begin(), verticals.end(), [](const segment& u, const segment& v) {
+        return point_less(u.p1, v.p1);
+    });
+}
+
+bool on_vertex_or_vertical(const vector<point>& vertices, const vector<segment>& verticals, const point& p) {
+    if (binary_search(vertices.begin(), vertices.end(), p, point_less)) {
+        return true;
+    }
+    auto v = upper_bound(verticals.begin(), verticals.end(), p, [](const point& q, const segment& u) {
+        return point_less(q, u.p1);
+    });
+    return v != verticals.begin() && (v - 1)->p1.x == p.x && p.y <= (v - 1)->p2.y;
+}
+
+slab_index make_slabs(const polygon& a) {
+    slab_index s;
+    s.nodes.push_back({-1, 0, 0, 0, 0});
+    split_edges(a, s.edges, s.verticals, s.vertices);
+    for (const point& p : s.vertices) {
+        s.xs.push_back(p.x);
+    }
+    s.xs.erase(unique(s.xs.begin(), s.xs.end()), s.xs.end());
+    int m = s.edges.size();
+    vector<int> starts(m), ends(m);
+    for (int i = 0; i < m; i++) {
+        starts[i] = ends[i] = i;
+    }
+    sort(starts.begin(), starts.end(), [&](int u, int v) {
+        return s.edges[u].p1.x < s.edges[v].p1.x;
+    });
+    sort(ends.begin(), ends.end(), [&](int u, int v) {
+        return s.edges[u].p2.x < s.edges[v].p2.x;
+    });
+    s.roots.resize(s.xs.size());
+    int root = 0;
+    int si = 0;
+    int ei = 0;
+    for (int i = 0; i < (int) s.xs.size(); i++) {
+        for (; ei < m && s.edges[ends[ei]].p2.x == s.xs[i]; ei++) {
+            root = erase(s, root, ends[ei]);
+        }
+        for (; si < m && s.edges[starts[si]].p1.x == s.xs[i]; si++) {
+            root = insert(s, root, starts[si]);
+        }
+        s.roots[i] = root;
+    }
+    return s;
+}
+
+// Read-only, so a built index can be queried from any number of threads.
+bool in_polygon(const slab_index& s, const point& p) {
+    if (on_vertex_or_vertical(s.vertices, s.verticals, p)) {
+        return true;
+    }
+    int i = upper_bound(s.xs.begin(), s.xs.end(), p.x) - s.xs.begin() - 1;
+    if (i < 0) {
+        return false;
+    }
+    int above = 0;
+    for (int t = s.roots[i]; t;) {
+        const slab_node& node = s.nodes[t];
+        int o = orientation(s.edges[node.edge], p);
+        if (o == 0) {
+            return true;
+        }
+        if (o < 0) {
+            above += 1 + s.nodes[node.right].size;
+            t = node.left;
+        } else {
+            t = node.right;
+        }
+    }
+    return above & 1;
+}
+
+// Keys below edges->size() are edges, the rest are query points; a query
+// compares equal to an edge it lies on.
+struct sweep_comp {
+    const vector<segment>* edges;
+    const vector<point>* queries;
+
+    bool operator ()(int a, int b) const {
+        int n = edges->size();
+        if (a < n && b < n) {
+            return edge_below((*edges)[a], (*edges)[b]);
+        }
+        if (a >= n) {
+            return orientation((*edges)[b], (*queries)[a - n]) < 0;
+        }
+        return orientation((*edges)[a], (*queries)[b - n]) > 0;
+    }
+};
+
+typedef __gnu_pbds::tree<int, __gnu_pbds::null_type, sweep_comp, __gnu_pbds::rb_tree_tag,
+                         __gnu_pbds::tree_order_statistics_node_update> sweep_status;
+
+// Offline point-in-polygon for a whole query set: one left-to-right sweep
+// over edge endpoints and queries, with each query's parity taken from the
+// number of active edges above it.
+vector<char> in_polygon_batch(const polygon& a, const vector<point>& queries) {
+    vector<segment> edges;
+    vector<segment> verticals;
+    vector<point> vertices;
+    split_edges(a, edges, verticals, vertices);
+    int n = edges.size();
+    int m = queries.size();
+    vector<int> starts(n), ends(n), order(m);
+    for (int i = 0; i < n; i++) {
+        starts[i] = ends[i] = i;
+    }
+    for (int i = 0; i < m; i++) {
+        order[i] = i;
+    }
+    sort(starts.begin(), starts.end(), [&](int u, int v) {
+        return edges[u].p1.x < edges[v].p1.x;
+    });
+    sort(ends.begin(), ends.end(), [&](int u, int v) {
+        return edges[u].p2.x < edges[v].p2.x;
+    });
+    sort(order.begin(), order.end(), [&](int u, int v) {
+        return queries[u].x < queries[v].x;
+    });
+    sweep_status status(sweep_comp{&edges, &queries});
+    vector<char> active(n);
+    vector<char> res(m);
+    int si = 0;
+    int ei = 0;
+    for (int q : order) {
+        const point& p = queries[q];
+        for (; ei < n && edges[ends[ei]].p2.x <= p.x; ei++) {
+            if (active[ends[ei]]) {
+                status.erase(ends[ei]);
+            }
+        }
+        for (; si < n && edges[starts[si]].p1.x <= p.x; si++) {
+            if (edges[starts[si]].p2.x > p.x) {
+                status.insert(starts[si]);
+                active[starts[si]] = true;
+            }
+        }
+        if (on_vertex_or_vertical(vertices, verticals, p)) {
+            res[q] = true;
+            continue;
+        }
+        int below = status.order_of_key(n + q);
+        auto it = status.find_by_order(below);
+        if (it != status.end() && orientation(edges[*it], p) == 0) {
+            res[q] = true;
+            continue;
+        }
+        res[q] = (status.size() - below) & 1;
+    }
+    return res;
+}
+
+// Edge-major vertex columns with the first vertex repeated at the end, so
+// edge i is (x[i], y[i]) -> (x[i + 1], y[i + 1]).
+struct polygon_soa {
+    vector<point> points;
+    vector<double> x;
+    vector<double> y;
+    bool exact;
+};
+
+// Below 2^25 every coordinate difference fits in 26 bits, both cross product
+// terms in 52 and their difference in 53, so double arithmetic is exact.
+const long long exact_limit = 1LL << 25;
+
+bool fits_exact(const point& p) {
+    return llabs(p.x) < exact_limit && llabs(p.y) < exact_limit;
+}
+
+polygon_soa make_soa(const polygon& a) {
+    polygon_soa s;
+    int n = a.points.size();
+    s.points = a.points;
+    s.x.resize(n + 1);
+    s.y.resize(n + 1);
+    s.exact = true;
+    for (int i = 0; i <= n; i++) {
+        const point& p = a.points[i % n];
+        s.x[i] = p.x;
+        s.y[i] = p.y;
+        s.exact &= fits_exact(p);
+    }
+    return s;
+}
+
+// Winding number of edges [from, to) around p; boundary is set when p lies on
+// one of them, in which case the count is meaningless.
+long long winding_scalar(const polygon_soa& s, const point& p, int from, int to, bool& boundary) {
+    int n = s.points.size();
+    long long wn = 0;
+    for (int i = from; i < to; i++) {
+        const point& a = s.points[i];
+        const point& b = s.points[(i + 1) % n];
+        long long c = pseudovec(vec({a, b}), vec({a, p}));
+        if (c == 0 && between({a, b}, p)) {
+            boundary = true;
+            return 0;
+        }
+        if (a.y <= p.y) {
+            wn += b.y > p.y && c > 0;
+        } else {
+            wn -= b.y <= p.y && c < 0;
+        }
+    }
+    return wn;
+}
+
+#ifdef __AVX2__
+long long winding_avx2(const polygon_soa& s, const point& p, int to, bool& boundary) {
+    const __m256d zero = _mm256_setzero_pd();
+    __m256d px = _mm256_set1_pd(p.x);
+    __m256d py = _mm256_set1_pd(p.y);
+    __m256i acc = _mm256_setzero_si256();
+    for (int i = 0; i < to; i += 4) {
+        __m256d ax = _mm256_loadu_pd(&s.x[i]);
+        __m256d ay = _mm256_loadu_pd(&s.y[i]);
+        __m256d bx = _mm256_loadu_pd(&s.x[i + 1]);
+        __m256d by = _mm256_loadu_pd(&s.y[i + 1]);
+        __m256d c = _mm256_sub_pd(_mm256_mul_pd(_mm256_sub_pd(bx, ax), _mm256_sub_pd(py, ay)),
+                                  _mm256_mul_pd(_mm256_sub_pd(px, ax), _mm256_sub_pd(by, ay)));
+        if (_mm256_movemask_pd(_mm256_cmp_pd(c, zero, _CMP_EQ_OQ))) {
+            winding_scalar(s, p, i, i + 4, boundary);
+            if (boundary) {
+                return 0;
+            }
+        }
+        __m256d up_a = _mm256_cmp_pd(ay, py, _CMP_LE_OQ);
+        __m256d up_b = _mm256_cmp_pd(by, py, _CMP_LE_OQ);
+        __m256d inc = _mm256_and_pd(_mm256_andnot_pd(up_b, up_a), _mm256_cmp_pd(c, zero, _CMP_GT_OQ));
+        __m256d dec = _mm256_and_pd(_mm256_andnot_pd(up_a, up_b), _mm256_cmp_pd(c, zero, _CMP_LT_OQ));
+        acc = _mm256_sub_epi64(acc, _mm256_castpd_si256(inc));
+        acc = _mm256_add_epi64(acc, _mm256_castpd_si256(dec));
+    }
+    long long lanes[4];
+    _mm256_storeu_si256((__m256i*) lanes, acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+#endif
+
+long long winding_number(const polygon_soa& s, const point& p, bool& boundary) {
+    int n = s.points.size();
+    boundary = false;
+#ifdef __AVX2__
+    if (s.exact && fits_exact(p)) {
+        int n4 = n & ~3;
+        long long wn = winding_avx2(s, p, n4, boundary);
+        if (boundary) {
+            return 0;
+        }
+        return wn + winding_scalar(s, p, n4, n, boundary);
+    }
+#endif
+    return winding_scalar(s, p, 0, n, boundary);
+}
+
+// Even-odd rule when nonzero is false, nonzero winding rule otherwise; the
+// latter also counts regions a self-overlapping outline covers twice.
+bool in_polygon(const polygon_soa& s, const point& p, bool nonzero) {
+    bool boundary;
+    long long wn = winding_number(s, p, boundary);
+    return boundary || (nonzero ? wn != 0 : (wn & 1));
+}
+
+polygon star_polygon(int n, long long r, mt19937& rnd) {
+    polygon a;
+    uniform_real_distribution<double> radius(0.3, 1.0);
+    for (int i = 0; i < n; i++) {
+        double t = 2 * M_PI * i / n;
+        double len = r * radius(rnd);
+        a.points.push_back({llround(len * cos(t)), llround(len * sin(t))});
+    }
+    return a;
+}
+
+void bench(int n, int m) {
+    using clock = chrono::steady_clock;
+    mt19937 rnd(n);
+    long long r = 1000000;
+    polygon a = star_polygon(n, r, rnd);
+    vector<point> queries(m);
+    uniform_int_distribution<long long> coord(-r, r);
+    for (point& q : queries) {
+        q = {coord(rnd), coord(rnd)};
+    }
+    point far = {-2 * r, 0};
+    polygon_soa s = make_soa(a);
+    auto t0 = clock::now();
+    int base = 0;
+    for (point& q : queries) {
+        far.y = q.y;
+        base += in_polygon(a, q, far);
+    }
+    auto t1 = clock::now();
+    int scalar = 0;
+    int winding = 0;
+    for (const point& q : queries) {
+        bool boundary;
+        long long wn = winding_scalar(s, q, 0, n, boundary);
+        scalar += boundary || (wn & 1);
+        winding += boundary || wn != 0;
+    }
+    auto t2 = clock::now();
+    int kernel = 0;
+    for (const point& q : queries) {
+        kernel += in_polygon(s, q, false);
+    }
+    auto t3 = clock::now();
+    double edges = (double) n * m;
+    cout << "vertices " << n << ", queries " << m << ", inside " << kernel << "\n";
+    cout << "intersect " << edges / chrono::duration<double>(t1 - t0).count() << " edges/s (inside " << base << ")\n";
+    cout << "scalar " << edges / chrono::duration<double>(t2 - t1).count() << " edges/s"
+         << (scalar == kernel && winding == kernel ? "" : " MISMATCH") << "\n";
+    cout << "kernel " << edges / chrono::duration<double>(t3 - t2).count() << " edges/s\n";
+}
+
+int main(int argc, char* argv[]) {
+    string mode = argc > 1 ? argv[1] : "";
+    if (mode == "bench") {
+        int m = argc > 2 ? atoi(argv[2]) : 200;
+        bench(100000, m);
+        bench(1000000, m);
+        return 0;
+    }
     int n;
     cin >> n;
     polygon poly;
@@ -115,6 +584,37 @@ int main() {
     reverse(poly.points.begin(), poly.points.begin() + minIndex);
     reverse(poly.points.begin() + minIndex, poly.points.end());
     reverse(poly.points.begin(), poly.points.end());
+    if (mode == "slabs") {
+        slab_index index = make_slabs(poly);
+        cout << (in_polygon(index, targetPoint) ? "YES" : "NO") << "\n";
+        int m;
+        if (cin >> m) {
+            for (int i = 0; i < m; i++) {
+                cin >> x >> y;
+                cout << (in_polygon(index, {x, y}) ? "YES" : "NO") << "\n";
+            }
+        }
+        return 0;
+    }
+    if (mode == "sweep") {
+        vector<point> queries = {targetPoint};
+        int m;
+        if (cin >> m) {
+            for (int i = 0; i < m; i++) {
+                cin >> x >> y;
+                queries.push_back({x, y});
+            }
+        }
+        for (char r : in_polygon_batch(poly, queries)) {
+            cout << (r ? "YES" : "NO") << "\n";
+        }
+        return 0;
+    }
+    if (mode == "crossing" || mode == "winding") {
+        polygon_soa soa = make_soa(poly);
+        cout << (in_polygon(soa, targetPoint, mode == "winding") ? "YES" : "NO") << endl;
+        return 0;
+    }
     if (in_polygon(poly, targetPoint, minPoint)) {
         cout << "YES" << endl;
     } else {
@@ -3,6 +3,20 @@
 #include <algorithm>
 #include <set>
 #include <iomanip>
+#include <limits>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include <cfloat>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 using namespace std;
 
@@ -34,22 +48,22 @@ int orientation(const segment& s, const point& p) {
     return 0;
 }
 
-point minPoint = {0, numeric_limits<long long>::max()};
-
 long long sqr_len(const point& a) {
     return a.x * a.x + a.y * a.y;
 }
 
 struct simple_comp {
-    bool operator()(const point& a, const point& b) {
+    bool operator()(const point& a, const point& b) const {
         return a.x < b.x || (a.x == b.x && a.y < b.y);
     }
 };
 
 struct points_comp {
-    bool operator ()(const point& a, const point& b) {
-        point left = {a.x - minPoint.x, a.y - minPoint.y};
-        point right = {b.x - minPoint.x, b.y - minPoint.y};
+    point origin;
+
+    bool operator ()(const point& a, const point& b) const {
+        point left = {a.x - origin.x, a.y - origin.y};
+        point right = {b.x - origin.x, b.y - origin.y};
         long long angle = pseudovec(left, right);
         if (angle == 0) {
             return sqr_len(left) < sqr_len(right);
@@ -58,42 +72,479 @@ struct points_comp {
     }
 };
 
-int main() {
-    int n;
-    cin >> n;
-    set<point, simple_comp> points;
-    for (int i = 0; i < n; i++) {
-        long long x, y;
-        cin >> x >> y;
-        points.insert({x, y});
-        if (y < minPoint.y) {
-            minPoint = {x, y};
-        }
+// Graham scan over st[0, n) in place. Leaves the hull counter-clockwise from
+// the lowest point (largest x among ties) at the front and returns its size.
+unsigned long graham_scan(point* st, unsigned long n) {
+    if (n < 2) {
+        return n;
     }
-    for (auto& p : points) {
-        if (p.y == minPoint.y && p.x > minPoint.x) {
-            minPoint = p;
+    unsigned long minIndex = 0;
+    for (unsigned long i = 1; i < n; i++) {
+        if (st[i].y < st[minIndex].y || (st[i].y == st[minIndex].y && st[i].x > st[minIndex].x)) {
+            minIndex = i;
         }
     }
-    points.erase(minPoint);
-    vector<point> st;
-    unsigned long sz = points.size() + 1;
-    st.reserve(sz);
-    st.push_back(minPoint);
-    for (const point& p : points) {
-        st.push_back(p);
-    }
-    sort(st.begin() + 1, st.end(), points_comp());
+    swap(st[0], st[minIndex]);
+    sort(st + 1, st + n, points_comp{st[0]});
     int lastIndex = 1;
-    for (int i = 2; i < sz; i++) {
-        while (orientation({st[lastIndex - 1], st[lastIndex]}, st[i]) <= 0 && lastIndex > 0) {
+    for (unsigned long i = 2; i < n; i++) {
+        while (lastIndex > 0 && orientation({st[lastIndex - 1], st[lastIndex]}, st[i]) <= 0) {
             lastIndex--;
         }
         swap(st[i], st[lastIndex + 1]);
         lastIndex++;
     }
-    sz = lastIndex + 1;
-    reverse(st.begin(), st.begin() + sz);
+    return lastIndex + 1;
+}
+
+vector<point> hull_set(const vector<point>& input) {
+    set<point, simple_comp> points(input.begin(), input.end());
+    vector<point> st(points.begin(), points.end());
+    st.resize(graham_scan(st.data(), st.size()));
+    reverse(st.begin(), st.end());
+    return st;
+}
+
+// LSD radix sort by (x, y) with 16-bit digits on keys offset by the minimum,
+// so only the digits the coordinate range actually spans are sorted on; a
+// pass whose digit is the same for every point is skipped as well.
+void radix_sort(vector<point>& points) {
+    const int bits = 16;
+    const unsigned long long mask = (1ULL << bits) - 1;
+    unsigned long n = points.size();
+    if (n < 2) {
+        return;
+    }
+    long long min_x = points[0].x, max_x = points[0].x;
+    long long min_y = points[0].y, max_y = points[0].y;
+    for (const point& p : points) {
+        min_x = min(min_x, p.x);
+        max_x = max(max_x, p.x);
+        min_y = min(min_y, p.y);
+        max_y = max(max_y, p.y);
+    }
+    vector<point> buf(n);
+    vector<unsigned long> count(1 << bits);
+    for (int key = 0; key < 2; key++) {
+        long long low = key == 0 ? min_y : min_x;
+        unsigned long long range = key == 0 ? (unsigned long long) max_y - min_y : (unsigned long long) max_x - min_x;
+        for (int shift = 0; shift < 64 && (range >> shift) > 0; shift += bits) {
+            auto digit = [&](const point& p) {
+                return (((unsigned long long) (key == 0 ? p.y : p.x) - low) >> shift) & mask;
+            };
+            fill(count.begin(), count.end(), 0);
+            for (const point& p : points) {
+                count[digit(p)]++;
+            }
+            if (count[digit(points[0])] == n) {
+                continue;
+            }
+            unsigned long sum = 0;
+            for (unsigned long& c : count) {
+                unsigned long t = c;
+                c = sum;
+                sum += t;
+            }
+            for (const point& p : points) {
+                buf[count[digit(p)]++] = p;
+            }
+            points.swap(buf);
+        }
+    }
+}
+
+// Andrew's monotone chain over one contiguous array: radix sort, in-place
+// dedupe, then lower and upper chains. Returns the same order as hull_set:
+// clockwise, ending at the lowest point (largest x among ties).
+vector<point> hull_flat(vector<point>& points) {
+    radix_sort(points);
+    points.erase(unique(points.begin(), points.end(), [](const point& a, const point& b) {
+        return a.x == b.x && a.y == b.y;
+    }), points.end());
+    unsigned long n = points.size();
+    if (n < 2) {
+        return points;
+    }
+    vector<point> st;
+    for (unsigned long i = 0; i < n; i++) {
+        while (st.size() >= 2 && orientation({st[st.size() - 2], st.back()}, points[i]) <= 0) {
+            st.pop_back();
+        }
+        st.push_back(points[i]);
+    }
+    unsigned long lower = st.size();
+    for (unsigned long i = n - 1; i-- > 0;) {
+        while (st.size() > lower && orientation({st[st.size() - 2], st.back()}, points[i]) <= 0) {
+            st.pop_back();
+        }
+        st.push_back(points[i]);
+    }
+    st.pop_back();
+    unsigned long m = 0;
+    for (unsigned long i = 1; i < st.size(); i++) {
+        if (st[i].y < st[m].y || (st[i].y == st[m].y && st[i].x > st[m].x)) {
+            m = i;
+        }
+    }
+    rotate(st.begin(), st.begin() + m, st.end());
+    reverse(st.begin(), st.end());
+    return st;
+}
+
+bool same_point(const point& a, const point& b) {
+    return a.x == b.x && a.y == b.y;
+}
+
+// Gift-wrapping order around p: b beats a when it lies clockwise of p -> a,
+// or on the same ray farther out. p itself never wins.
+bool wrap_better(const point& p, const point& a, const point& b) {
+    if (same_point(b, p)) {
+        return false;
+    }
+    if (same_point(a, p)) {
+        return true;
+    }
+    int o = orientation({p, a}, b);
+    if (o != 0) {
+        return o < 0;
+    }
+    point da = {a.x - p.x, a.y - p.y};
+    point db = {b.x - p.x, b.y - p.y};
+    return da.x * db.x + da.y * db.y > 0 && sqr_len(db) > sqr_len(da);
+}
+
+// Index of the vertex of the counter-clockwise hull h[0, k) that p wraps to.
+// p is never strictly inside h, so the polar angle of h[i] around p is
+// cyclically unimodal along h; the minimum is found by binary search from
+// whichever side of h[0] the angle decreases. The answer is then checked
+// against its neighbours, which suffices on a convex chain, and anything
+// degenerate falls back to a linear scan.
+unsigned long wrap_tangent(const point* h, unsigned long k, const point& p) {
+    if (k < 3) {
+        return k == 2 && wrap_better(p, h[0], h[1]) ? 1 : 0;
+    }
+    int dir = orientation({p, h[0]}, h[1]) < 0 ? 1 : orientation({p, h[0]}, h[k - 1]) < 0 ? -1 : 0;
+    auto at = [&](unsigned long i) -> const point& {
+        return h[dir > 0 ? i % k : (k - i % k) % k];
+    };
+    unsigned long c = 0;
+    if (dir != 0) {
+        unsigned long lo = 0;
+        unsigned long hi = k - 1;
+        while (lo < hi) {
+            unsigned long mid = (lo + hi) / 2;
+            if (orientation({p, at(mid)}, at(mid + 1)) < 0 && orientation({p, h[0]}, at(mid)) <= 0) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        c = dir > 0 ? lo % k : (k - lo % k) % k;
+    }
+    if (same_point(h[c], p) || wrap_better(p, h[c], h[(c + 1) % k])) {
+        c = (c + 1) % k;
+    } else if (wrap_better(p, h[c], h[(c + k - 1) % k])) {
+        c = (c + k - 1) % k;
+    }
+    if (!wrap_better(p, h[c], h[(c + k - 1) % k]) && !wrap_better(p, h[c], h[(c + 1) % k])) {
+        return c;
+    }
+    unsigned long best = 0;
+    for (unsigned long i = 1; i < k; i++) {
+        if (wrap_better(p, h[best], h[i])) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+// Chan's algorithm: for group sizes m = 2^2^t from 256 up (smaller rounds cost
+// more in per-group overhead than they can save), Graham-scan the n / m groups
+// (in parallel) and gift-wrap at most m steps with one tangent search per
+// group, until the wrap closes. O(n log h) overall; same output order as
+// hull_set.
+vector<point> hull_chan(const vector<point>& points, unsigned int threads) {
+    unsigned long n = points.size();
+    if (n == 0) {
+        return {};
+    }
+    point start = points[0];
+    for (const point& p : points) {
+        if (p.y < start.y || (p.y == start.y && p.x > start.x)) {
+            start = p;
+        }
+    }
+    vector<point> buf(n);
+    vector<unsigned long> sizes;
+    for (unsigned int t = 3;; t++) {
+        unsigned long m = t >= 6 ? n : min(n, 1UL << (1U << t));
+        unsigned long groups = (n + m - 1) / m;
+        copy(points.begin(), points.end(), buf.begin());
+        sizes.assign(groups, 0);
+        auto scan = [&](unsigned long from, unsigned long to) {
+            for (unsigned long g = from; g < to; g++) {
+                sizes[g] = graham_scan(&buf[g * m], min(m, n - g * m));
+            }
+        };
+        unsigned long per = (groups + threads - 1) / threads;
+        vector<thread> pool;
+        for (unsigned long g = per; g < groups; g += per) {
+            pool.emplace_back(scan, g, min(groups, g + per));
+        }
+        scan(0, min(groups, per));
+        for (thread& th : pool) {
+            th.join();
+        }
+        vector<point> hull = {start};
+        point p = start;
+        long cur_group = -1;
+        unsigned long cur_index = 0;
+        bool closed = false;
+        for (unsigned long step = 0; step < m; step++) {
+            point best = p;
+            long best_group = -1;
+            unsigned long best_index = 0;
+            for (unsigned long g = 0; g < groups; g++) {
+                const point* h = &buf[g * m];
+                unsigned long i = (long) g == cur_group ? (cur_index + 1) % sizes[g] : wrap_tangent(h, sizes[g], p);
+                if (wrap_better(p, best, h[i])) {
+                    best = h[i];
+                    best_group = g;
+                    best_index = i;
+                }
+            }
+            if (best_group < 0 || same_point(best, start)) {
+                closed = true;
+                break;
+            }
+            hull.push_back(best);
+            p = best;
+            cur_group = best_group;
+            cur_index = best_index;
+        }
+        if (closed) {
+            reverse(hull.begin(), hull.end());
+            return hull;
+        }
+    }
+}
+
+// Akl-Toussaint: the extremes in x, y, x + y and x - y span an octagon inside
+// the hull, and nothing strictly inside it can be a hull vertex.
+const long long octagon_limit = 1LL << 30;
+const double octagon_eps = DBL_EPSILON / 2;
+const double octagon_errbound = (3.0 + 16.0 * octagon_eps) * octagon_eps;
+
+vector<point> octagon(const vector<point>& points) {
+    point ext[8];
+    fill(ext, ext + 8, points[0]);
+    for (const point& p : points) {
+        if (p.y < ext[0].y) {
+            ext[0] = p;
+        }
+        if (p.x - p.y > ext[1].x - ext[1].y) {
+            ext[1] = p;
+        }
+        if (p.x > ext[2].x) {
+            ext[2] = p;
+        }
+        if (p.x + p.y > ext[3].x + ext[3].y) {
+            ext[3] = p;
+        }
+        if (p.y > ext[4].y) {
+            ext[4] = p;
+        }
+        if (p.x - p.y < ext[5].x - ext[5].y) {
+            ext[5] = p;
+        }
+        if (p.x < ext[6].x) {
+            ext[6] = p;
+        }
+        if (p.x + p.y < ext[7].x + ext[7].y) {
+            ext[7] = p;
+        }
+    }
+    vector<point> oct;
+    for (const point& p : ext) {
+        if (oct.empty() || p.x != oct.back().x || p.y != oct.back().y) {
+            oct.push_back(p);
+        }
+    }
+    while (oct.size() > 1 && oct.back().x == oct[0].x && oct.back().y == oct[0].y) {
+        oct.pop_back();
+    }
+    return oct;
+}
+
+bool strictly_inside(const vector<point>& oct, const point& p) {
+    for (unsigned long i = 0; i < oct.size(); i++) {
+        if (orientation({oct[i], oct[(i + 1) % oct.size()]}, p) <= 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Drops every point strictly inside the octagon and returns how many went.
+// Only runs when all coordinates are below 2^30, where the integer cross
+// products cannot overflow; the AVX2 path drops a point only when the
+// double result clears the rounding bound, so it never drops a hull vertex.
+unsigned long octagon_filter(vector<point>& points) {
+    unsigned long n = points.size();
+    if (n < 8) {
+        return 0;
+    }
+    for (const point& p : points) {
+        if (llabs(p.x) >= octagon_limit || llabs(p.y) >= octagon_limit) {
+            return 0;
+        }
+    }
+    vector<point> oct = octagon(points);
+    if (oct.size() < 3) {
+        return 0;
+    }
+    unsigned long w = 0;
+    unsigned long i = 0;
+#ifdef __AVX2__
+    int k = oct.size();
+    __m256d ax[8], ay[8], ex[8], ey[8];
+    for (int e = 0; e < k; e++) {
+        ax[e] = _mm256_set1_pd(oct[e].x);
+        ay[e] = _mm256_set1_pd(oct[e].y);
+        ex[e] = _mm256_set1_pd(oct[(e + 1) % k].x - oct[e].x);
+        ey[e] = _mm256_set1_pd(oct[(e + 1) % k].y - oct[e].y);
+    }
+    const __m256i low = _mm256_setr_epi32(0, 4, 2, 6, 0, 4, 2, 6);
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    const __m256d errbound = _mm256_set1_pd(octagon_errbound);
+    for (; i + 4 <= n; i += 4) {
+        __m256i v0 = _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i*) &points[i]), low);
+        __m256i v1 = _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i*) &points[i + 2]), low);
+        __m128i lo0 = _mm256_castsi256_si128(v0);
+        __m128i lo1 = _mm256_castsi256_si128(v1);
+        __m256d px = _mm256_cvtepi32_pd(_mm_unpacklo_epi64(lo0, lo1));
+        __m256d py = _mm256_cvtepi32_pd(_mm_unpackhi_epi64(lo0, lo1));
+        __m256d inside = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+        for (int e = 0; e < k; e++) {
+            __m256d l = _mm256_mul_pd(ex[e], _mm256_sub_pd(py, ay[e]));
+            __m256d r = _mm256_mul_pd(ey[e], _mm256_sub_pd(px, ax[e]));
+            __m256d bound = _mm256_mul_pd(errbound, _mm256_add_pd(_mm256_andnot_pd(sign, l), _mm256_andnot_pd(sign, r)));
+            inside = _mm256_and_pd(inside, _mm256_cmp_pd(_mm256_sub_pd(l, r), bound, _CMP_GT_OQ));
+        }
+        int mask = _mm256_movemask_pd(inside);
+        for (int j = 0; j < 4; j++) {
+            if (!(mask >> j & 1)) {
+                points[w++] = points[i + j];
+            }
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        if (!strictly_inside(oct, points[i])) {
+            points[w++] = points[i];
+        }
+    }
+    points.resize(w);
+    return n - w;
+}
+
+// Sequential reader over a memory-mapped point file. The mapping is marked
+// MADV_SEQUENTIAL, prefetch() asks for the next window with MADV_WILLNEED and
+// drops the pages already parsed, so residency stays around one window.
+struct mapped_reader {
+    static constexpr size_t window = 64 << 20;
+    const char* data = nullptr;
+    size_t size = 0;
+    size_t pos = 0;
+    size_t released = 0;
+    size_t page = sysconf(_SC_PAGESIZE);
+
+    ~mapped_reader() {
+        if (data != nullptr) {
+            munmap((void*) data, size);
+        }
+    }
+
+    bool open(const char* path) {
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        bool ok = fstat(fd, &st) == 0;
+        size = ok ? st.st_size : 0;
+        if (ok && size > 0) {
+            void* m = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ok = m != MAP_FAILED;
+            if (ok) {
+                data = (const char*) m;
+                madvise(m, size, MADV_SEQUENTIAL);
+            }
+        }
+        close(fd);
+        return ok;
+    }
+
+    void prefetch() {
+        size_t from = pos / page * page;
+        if (from > released) {
+            madvise((void*) (data + released), from - released, MADV_DONTNEED);
+            released = from;
+        }
+        if (from < size) {
+            madvise((void*) (data + from), min(window, size - from), MADV_WILLNEED);
+        }
+    }
+
+    bool next(long long& v) {
+        while (pos < size && (data[pos] == ' ' || data[pos] == '\n' || data[pos] == '\r' || data[pos] == '\t')) {
+            pos++;
+        }
+        bool neg = pos < size && data[pos] == '-';
+        if (neg) {
+            pos++;
+        }
+        size_t start = pos;
+        unsigned long long r = 0;
+        while (pos < size && data[pos] >= '0' && data[pos] <= '9') {
+            r = r * 10 + (data[pos++] - '0');
+        }
+        v = neg ? -(long long) r : (long long) r;
+        return pos > start;
+    }
+};
+
+// Hull of a point file that need not fit in memory: every chunk of up to
+// `chunk` points is hulled together with the running hull, so only one chunk
+// plus the hull is held at a time. Same order as hull_flat.
+vector<point> hull_stream(mapped_reader& in, unsigned long chunk) {
+    vector<point> hull;
+    long long n;
+    if (!in.next(n)) {
+        return hull;
+    }
+    vector<point> buf;
+    long long read = 0;
+    bool more = true;
+    while (more && read < n) {
+        in.prefetch();
+        buf.assign(hull.begin(), hull.end());
+        for (unsigned long i = 0; i < chunk && read < n; i++, read++) {
+            point p;
+            if (!in.next(p.x) || !in.next(p.y)) {
+                more = false;
+                break;
+            }
+            buf.push_back(p);
+        }
+        octagon_filter(buf);
+        hull = hull_flat(buf);
+    }
+    return hull;
+}
+
+void print_hull(const vector<point>& st) {
+    unsigned long sz = st.size();
     cout << sz << endl;
     for (int i = 0; i < sz; i++) {
         cout << st[i].x << " " << st[i].y << endl;
@@ -106,5 +557,426 @@ int main() {
     }
     s = (long double) abs(sum) * 0.5;
     cout << setprecision(20) << s << endl;
+}
+
+// Convex hull under insertions and deletions (Overmars-van Leeuwen). Points
+// sit in the leaves of an AVL tree in (x, y) order and every internal node
+// keeps the bridge joining its children's upper hulls, plus the vertex count
+// and cross-product sum of its own upper hull. The lower hull is the upper
+// hull of the negated points, so each node stores both through frame().
+// Coordinates must stay below 2^30 in absolute value.
+struct chain_stats {
+    long long cnt;
+    __int128 s;
+    point first;
+    point last;
+};
+
+struct hull_node {
+    int left;
+    int right;
+    int height;
+    int count;
+    point lo;
+    point hi;
+    point bridge[2][2];
+    chain_stats chain[2];
+};
+
+point frame(const point& p, int h) {
+    return h ? point{-p.x, -p.y} : p;
+}
+
+bool point_less(const point& a, const point& b) {
+    return simple_comp()(a, b);
+}
+
+int sign128(__int128 v) {
+    return v < 0 ? -1 : v > 0;
+}
+
+// Whether the intersection of lines ab and cd is lexicographically below m.
+bool intersection_before(const point& a, const point& b, const point& c, const point& d, const point& m) {
+    __int128 dx = d.x - c.x;
+    __int128 dy = d.y - c.y;
+    __int128 num = (__int128) (c.x - a.x) * dy - (__int128) (c.y - a.y) * dx;
+    __int128 den = (__int128) (b.x - a.x) * dy - (__int128) (b.y - a.y) * dx;
+    int sx = sign128((a.x - m.x) * den + (b.x - a.x) * num) * sign128(den);
+    if (sx != 0) {
+        return sx < 0;
+    }
+    return sign128((a.y - m.y) * den + (b.y - a.y) * num) * sign128(den) < 0;
+}
+
+struct dynamic_hull {
+    vector<hull_node> nodes;
+    vector<int> free_nodes;
+    int root = -1;
+
+    bool leaf(int u) const {
+        return nodes[u].left < 0;
+    }
+
+    int first(int u, int h) const {
+        return h ? nodes[u].right : nodes[u].left;
+    }
+
+    int second(int u, int h) const {
+        return h ? nodes[u].left : nodes[u].right;
+    }
+
+    int height(int u) const {
+        return u < 0 ? 0 : nodes[u].height;
+    }
+
+    int new_node() {
+        if (!free_nodes.empty()) {
+            int u = free_nodes.back();
+            free_nodes.pop_back();
+            return u;
+        }
+        nodes.push_back({});
+        return nodes.size() - 1;
+    }
+
+    int new_leaf(const point& p) {
+        int u = new_node();
+        nodes[u].left = nodes[u].right = -1;
+        nodes[u].height = 1;
+        nodes[u].count = 1;
+        nodes[u].lo = nodes[u].hi = p;
+        for (int h = 0; h < 2; h++) {
+            nodes[u].chain[h] = {1, 0, frame(p, h), frame(p, h)};
+        }
+        return u;
+    }
+
+    // Vertices of u's hull up to and including t, and from t on; t must be
+    // a vertex of that hull. Each call descends one level.
+    chain_stats prefix_upto(int u, const point& t, int h) const {
+        if (leaf(u)) {
+            return nodes[u].chain[h];
+        }
+        if (!point_less(nodes[u].bridge[h][0], t)) {
+            return prefix_upto(first(u, h), t, h);
+        }
+        chain_stats rest = suffix_from(second(u, h), t, h);
+        const chain_stats& all = nodes[u].chain[h];
+        return {all.cnt - rest.cnt + 1, all.s - rest.s, all.first, t};
+    }
+
+    chain_stats suffix_from(int u, const point& t, int h) const {
+        if (leaf(u)) {
+            return nodes[u].chain[h];
+        }
+        if (!point_less(t, nodes[u].bridge[h][1])) {
+            return suffix_from(second(u, h), t, h);
+        }
+        chain_stats rest = prefix_upto(first(u, h), t, h);
+        const chain_stats& all = nodes[u].chain[h];
+        return {all.cnt - rest.cnt + 1, all.s - rest.s, t, all.last};
+    }
+
+    void find_bridge(int v, int h) {
+        int x = first(v, h);
+        int y = second(v, h);
+        point m = frame(h ? nodes[nodes[v].left].hi : nodes[nodes[v].right].lo, h);
+        while (!leaf(x) || !leaf(y)) {
+            point a = leaf(x) ? frame(nodes[x].lo, h) : nodes[x].bridge[h][0];
+            point b = leaf(x) ? a : nodes[x].bridge[h][1];
+            point c = leaf(y) ? frame(nodes[y].lo, h) : nodes[y].bridge[h][0];
+            point d = leaf(y) ? c : nodes[y].bridge[h][1];
+            if (!leaf(x) && orientation({a, b}, c) >= 0) {
+                x = first(x, h);
+            } else if (!leaf(y) && orientation({c, d}, b) >= 0) {
+                y = second(y, h);
+            } else if (leaf(x)) {
+                y = first(y, h);
+            } else if (leaf(y)) {
+                x = second(x, h);
+            } else if (intersection_before(a, b, c, d, m)) {
+                x = second(x, h);
+            } else {
+                y = first(y, h);
+            }
+        }
+        nodes[v].bridge[h][0] = frame(nodes[x].lo, h);
+        nodes[v].bridge[h][1] = frame(nodes[y].lo, h);
+    }
+
+    void pull(int v) {
+        int l = nodes[v].left;
+        int r = nodes[v].right;
+        nodes[v].height = 1 + max(nodes[l].height, nodes[r].height);
+        nodes[v].lo = nodes[l].lo;
+        nodes[v].hi = nodes[r].hi;
+        for (int h = 0; h < 2; h++) {
+            find_bridge(v, h);
+            const point& a = nodes[v].bridge[h][0];
+            const point& b = nodes[v].bridge[h][1];
+            chain_stats p = prefix_upto(first(v, h), a, h);
+            chain_stats q = suffix_from(second(v, h), b, h);
+            nodes[v].chain[h] = {p.cnt + q.cnt, p.s + pseudovec(a, b) + q.s, p.first, q.last};
+        }
+    }
+
+    int rotate_right(int v) {
+        int l = nodes[v].left;
+        nodes[v].left = nodes[l].right;
+        pull(v);
+        nodes[l].right = v;
+        pull(l);
+        return l;
+    }
+
+    int rotate_left(int v) {
+        int r = nodes[v].right;
+        nodes[v].right = nodes[r].left;
+        pull(v);
+        nodes[r].left = v;
+        pull(r);
+        return r;
+    }
+
+    int balance(int v) {
+        int l = nodes[v].left;
+        int r = nodes[v].right;
+        if (height(l) > height(r) + 1) {
+            if (height(nodes[l].left) < height(nodes[l].right)) {
+                nodes[v].left = rotate_left(l);
+            }
+            return rotate_right(v);
+        }
+        if (height(r) > height(l) + 1) {
+            if (height(nodes[r].right) < height(nodes[r].left)) {
+                nodes[v].right = rotate_right(r);
+            }
+            return rotate_left(v);
+        }
+        pull(v);
+        return v;
+    }
+
+    int insert(int v, const point& p) {
+        if (v < 0) {
+            return new_leaf(p);
+        }
+        if (leaf(v)) {
+            if (p.x == nodes[v].lo.x && p.y == nodes[v].lo.y) {
+                nodes[v].count++;
+                return v;
+            }
+            int u = new_leaf(p);
+            int w = new_node();
+            nodes[w].left = point_less(p, nodes[v].lo) ? u : v;
+            nodes[w].right = point_less(p, nodes[v].lo) ? v : u;
+            pull(w);
+            return w;
+        }
+        if (point_less(p, nodes[nodes[v].right].lo)) {
+            int l = insert(nodes[v].left, p);
+            nodes[v].left = l;
+        } else {
+            int r = insert(nodes[v].right, p);
+            nodes[v].right = r;
+        }
+        return balance(v);
+    }
+
+    int erase(int v, const point& p) {
+        if (v < 0) {
+            return v;
+        }
+        if (leaf(v)) {
+            if (p.x != nodes[v].lo.x || p.y != nodes[v].lo.y || --nodes[v].count > 0) {
+                return v;
+            }
+            free_nodes.push_back(v);
+            return -1;
+        }
+        bool left = point_less(p, nodes[nodes[v].right].lo);
+        int c = erase(left ? nodes[v].left : nodes[v].right, p);
+        if (c < 0) {
+            free_nodes.push_back(v);
+            return left ? nodes[v].right : nodes[v].left;
+        }
+        if (left) {
+            nodes[v].left = c;
+        } else {
+            nodes[v].right = c;
+        }
+        return balance(v);
+    }
+
+    void insert(const point& p) {
+        root = insert(root, p);
+    }
+
+    void erase(const point& p) {
+        root = erase(root, p);
+    }
+
+    long long size() const {
+        if (root < 0) {
+            return 0;
+        }
+        if (leaf(root)) {
+            return 1;
+        }
+        return nodes[root].chain[0].cnt + nodes[root].chain[1].cnt - 2;
+    }
+
+    long double area() const {
+        if (root < 0) {
+            return 0;
+        }
+        __int128 s = nodes[root].chain[0].s + nodes[root].chain[1].s;
+        return (long double) (s < 0 ? -s : s) * 0.5;
+    }
+
+    // Appends the vertices of u's hull in [lo, hi] (null for unbounded).
+    void emit(int u, int h, const point* lo, const point* hi, vector<point>& out) const {
+        if (leaf(u)) {
+            point p = frame(nodes[u].lo, h);
+            if ((!lo || !point_less(p, *lo)) && (!hi || !point_less(*hi, p))) {
+                out.push_back(frame(p, h));
+            }
+            return;
+        }
+        point a = nodes[u].bridge[h][0];
+        point b = nodes[u].bridge[h][1];
+        const point* to = hi && point_less(*hi, a) ? hi : &a;
+        if (!lo || !point_less(*to, *lo)) {
+            emit(first(u, h), h, lo, to, out);
+        }
+        const point* from = lo && point_less(b, *lo) ? lo : &b;
+        if (!hi || !point_less(*hi, *from)) {
+            emit(second(u, h), h, from, hi, out);
+        }
+    }
+
+    // Hull vertices in the order print_hull expects: clockwise, ending at
+    // the lowest point (largest x among ties).
+    vector<point> vertices() const {
+        vector<point> st;
+        if (root < 0) {
+            return st;
+        }
+        emit(root, 0, nullptr, nullptr, st);
+        if (leaf(root)) {
+            return st;
+        }
+        vector<point> lower;
+        emit(root, 1, nullptr, nullptr, lower);
+        st.insert(st.end(), lower.begin() + 1, lower.end() - 1);
+        unsigned long m = 0;
+        for (unsigned long i = 1; i < st.size(); i++) {
+            if (st[i].y < st[m].y || (st[i].y == st[m].y && st[i].x > st[m].x)) {
+                m = i;
+            }
+        }
+        rotate(st.begin(), st.begin() + m + 1, st.end());
+        return st;
+    }
+};
+
+// Reads q operations: "+ x y" inserts, "- x y" deletes one copy, "?" prints
+// hull size and area, "!" prints the hull as the batch mode does.
+void run_dynamic() {
+    dynamic_hull hull;
+    int q;
+    cin >> q;
+    for (int i = 0; i < q; i++) {
+        string op;
+        cin >> op;
+        if (op == "+" || op == "-") {
+            point p;
+            cin >> p.x >> p.y;
+            if (op == "+") {
+                hull.insert(p);
+            } else {
+                hull.erase(p);
+            }
+        } else if (op == "?") {
+            cout << hull.size() << " " << setprecision(20) << hull.area() << "\n";
+        } else if (op == "!") {
+            print_hull(hull.vertices());
+        }
+    }
+}
+
+void bench(unsigned long n) {
+    using clock = chrono::steady_clock;
+    mt19937_64 rnd(n);
+    uniform_int_distribution<long long> coord(-1000000000, 1000000000);
+    vector<point> points(n);
+    for (point& p : points) {
+        p = {coord(rnd), coord(rnd)};
+    }
+    vector<point> copy = points;
+    auto t0 = clock::now();
+    vector<point> flat = hull_flat(copy);
+    auto t1 = clock::now();
+    copy = points;
+    auto t2 = clock::now();
+    unsigned long removed = octagon_filter(copy);
+    vector<point> filtered = hull_flat(copy);
+    auto t3 = clock::now();
+    vector<point> chan = hull_chan(points, max(1u, thread::hardware_concurrency()));
+    auto t4 = clock::now();
+    vector<point> old = hull_set(points);
+    auto t5 = clock::now();
+    auto same = [](const vector<point>& a, const vector<point>& b) {
+        if (a.size() != b.size()) {
+            return false;
+        }
+        for (unsigned long i = 0; i < a.size(); i++) {
+            if (a[i].x != b[i].x || a[i].y != b[i].y) {
+                return false;
+            }
+        }
+        return true;
+    };
+    cout << "points " << n << ", hull " << flat.size() << (same(flat, old) && same(filtered, old) && same(chan, old) ? "" : " MISMATCH") << "\n";
+    cout << "flat " << n / chrono::duration<double>(t1 - t0).count() << " points/s\n";
+    cout << "octagon+flat " << n / chrono::duration<double>(t3 - t2).count() << " points/s (removed " << removed << ")\n";
+    cout << "chan " << n / chrono::duration<double>(t4 - t3).count() << " points/s\n";
+    cout << "set " << n / chrono::duration<double>(t5 - t4).count() << " points/s\n";
+}
+
+int main(int argc, char* argv[]) {
+    string mode = argc > 1 ? argv[1] : "";
+    if (mode == "bench") {
+        bench(argc > 2 ? atol(argv[2]) : 10000000);
+        return 0;
+    }
+    if (mode == "dynamic") {
+        run_dynamic();
+        return 0;
+    }
+    if (mode == "stream") {
+        mapped_reader in;
+        if (argc < 3 || !in.open(argv[2])) {
+            cerr << "usage: f stream <file> [chunk points]" << endl;
+            return 1;
+        }
+        print_hull(hull_stream(in, argc > 3 ? max(1L, atol(argv[3])) : 1 << 20));
+        return 0;
+    }
+    int n;
+    cin >> n;
+    vector<point> points(n);
+    for (int i = 0; i < n; i++) {
+        cin >> points[i].x >> points[i].y;
+    }
+    if (mode == "chan") {
+        unsigned int threads = argc > 2 ? max(1, atoi(argv[2])) : max(1u, thread::hardware_concurrency());
+        print_hull(hull_chan(points, threads));
+        return 0;
+    }
+    if (mode == "octagon") {
+        cerr << "octagon filter removed " << octagon_filter(points) << " of " << n << " points" << endl;
+    }
+    print_hull(mode == "set" ? hull_set(points) : hull_flat(points));
     return 0;
-}
\ No newline at end of file
+}
@@ -3,6 +3,14 @@
 #include <algorithm>
 #include <iomanip>
 #include <cmath>
+#include <limits>
+#include <string>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include <atomic>
+#include <mutex>
 
 using namespace std;
 
@@ -135,7 +143,7 @@ bool intersect(const point& p1, const point& p2, const point& p3, const point& p
 
 bool in_polygon(const vector<point>& a, const point& p) {
     int l = 1;
-    int r = a.size();
+    int r = a.size() - 1;
     if (orientation({a[0], a[1]}, p) < 0
         || orientation({a[0], a.back()}, p) > 0) {
         return false;
@@ -186,16 +194,38 @@ long double min_seg_distance(const segment& s, vector<point>& poly) {
     return min_dist;
 }
 
-int main() {
-    int n;
-    cin >> n;
-    vector<point> a(n);
-    int min_index_a = 0;
-    for (int i = 0; i < n; i++) {
-        long long x, y;
-        cin >> x >> y;
-        a[i] = {x, y};
+// Merges two convex polygons, counter-clockwise from their leftmost lowest
+// vertices, into their Minkowski sum by walking both boundaries by edge angle.
+vector<point> convex_sum(const vector<point>& a, const vector<point>& b) {
+    int n = a.size();
+    int m = b.size();
+    vector<point> sum;
+    int i = 0;
+    int j = 0;
+    while (i < n || j < m) {
+        int i_cur = i % n;
+        int j_cur = j % m;
+        sum.push_back(a[i_cur] + b[j_cur]);
+        int i_next = (i + 1) % n;
+        int j_next = (j + 1) % m;
+        if (comp_by_angle({a[i_cur], a[i_next]}, {b[j_cur], b[j_next]})) {
+            i++;
+        } else if (comp_by_angle({b[j_cur], b[j_next]}, {a[i_cur], a[i_next]})) {
+            j++;
+        } else {
+            i++;
+            j++;
+        }
     }
+    return sum;
+}
+
+// Distance between two convex polygons given clockwise, through the full
+// Minkowski sum of a and -b.
+long double minkowski_dist(vector<point> a, vector<point> b) {
+    int n = a.size();
+    int m = b.size();
+    int min_index_a = 0;
     reverse(a.begin(), a.end());
     for (int i = 0; i < n; i++) {
         if (a[i].x < a[min_index_a].x) {
@@ -211,30 +241,18 @@ int main() {
     reverse(a.begin(), a.begin() + min_index_a);
     reverse(a.begin() + min_index_a, a.end());
     reverse(a.begin(), a.end());
-    int m;
-    cin >> m;
-    vector<point> b(m);
     int min_index_b = 0;
-    for (int i = 0; i < m; i++) {
-        long long x, y;
-        cin >> x >> y;
-        b[i] = {x, y};
-    }
     if (n == 1) {
-        cout << fixed << setprecision(20) << min_dist(a[0], b);
-        return 0;
+        return min_dist(a[0], b);
     }
     if (m == 1) {
-        cout << fixed << setprecision(20) << min_dist(b[0], a);
-        return 0;
+        return min_dist(b[0], a);
     }
     if (n == 2) {
-        cout << fixed << setprecision(20) << min_seg_distance({a[0], a[1]}, b);
-        return 0;
+        return min_seg_distance({a[0], a[1]}, b);
     }
     if (m == 2) {
-        cout << fixed << setprecision(20) << min_seg_distance({b[0], b[1]}, a);
-        return 0;
+        return min_seg_distance({b[0], b[1]}, a);
     }
     for (int i = 0; i < m; i++) {
         b[i] = {-b[i].x, -b[i].y};
@@ -255,25 +273,654 @@ int main() {
     reverse(b.begin() + min_index_b, b.end());
     reverse(b.begin(), b.end());
 
-    vector<point> sum;
+    vector<point> sum = convex_sum(a, b);
     point start = {0, 0};
-    int i = 0;
-    int j = 0;
-    while (i < n || j < m) {
-        int i_cur = i % n;
-        int j_cur = j % m;
-        sum.push_back(a[i_cur] + b[j_cur]);
-        int i_next = (i + 1) % n;
-        int j_next = (j + 1) % m;
-        if (comp_by_angle({a[i_cur], a[i_next]}, {b[j_cur], b[j_next]})) {
-            i++;
-        } else if (comp_by_angle({b[j_cur], b[j_next]}, {a[i_cur], a[i_next]})) {
-            j++;
-        } else {
-            i++;
-            j++;
+    return min_dist(start, sum);
+}
+
+// Query engine for distances between preloaded convex polygons. A shape is
+// stored as its strictly convex hull, counter-clockwise from the leftmost
+// lowest vertex, once as itself and once negated, so both lists of edge
+// vectors are sorted by angle in (-90, 270] degrees.
+struct convex_shape {
+    vector<point> v;
+    vector<point> e;
+    vector<point> neg_v;
+    vector<point> neg_e;
+};
+
+bool point_less(const point& a, const point& b) {
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+void hull_edges(const vector<point>& pts, vector<point>& v, vector<point>& e) {
+    vector<point> sorted = pts;
+    sort(sorted.begin(), sorted.end(), point_less);
+    sorted.erase(unique(sorted.begin(), sorted.end(), [](const point& a, const point& b) {
+        return a.x == b.x && a.y == b.y;
+    }), sorted.end());
+    v.clear();
+    if (sorted.size() < 3) {
+        v = sorted;
+    } else {
+        for (int pass = 0; pass < 2; pass++) {
+            unsigned long lower = v.size();
+            for (unsigned long i = 0; i < sorted.size(); i++) {
+                const point& p = pass == 0 ? sorted[i] : sorted[sorted.size() - 1 - i];
+                while (v.size() >= lower + 2 && orientation({v[v.size() - 2], v.back()}, p) <= 0) {
+                    v.pop_back();
+                }
+                v.push_back(p);
+            }
+            v.pop_back();
+        }
+    }
+    e.clear();
+    if (v.size() > 1) {
+        for (unsigned long i = 0; i < v.size(); i++) {
+            e.push_back(vec({v[i], v[(i + 1) % v.size()]}));
+        }
+    }
+}
+
+convex_shape make_shape(const vector<point>& poly) {
+    convex_shape s;
+    hull_edges(poly, s.v, s.e);
+    vector<point> neg(poly.size());
+    for (unsigned long i = 0; i < poly.size(); i++) {
+        neg[i] = {-poly[i].x, -poly[i].y};
+    }
+    hull_edges(neg, s.neg_v, s.neg_e);
+    return s;
+}
+
+// Strict order of edge vectors by angle in (-90, 270] degrees.
+bool edge_less(const point& a, const point& b) {
+    bool ha = a.x < 0 || (a.x == 0 && a.y < 0);
+    bool hb = b.x < 0 || (b.x == 0 && b.y < 0);
+    if (ha != hb) {
+        return hb;
+    }
+    return pseudovec(a, b) > 0;
+}
+
+bool same_direction(const point& a, const point& b) {
+    return pseudovec(a, b) == 0 && a.x * b.x + a.y * b.y > 0;
+}
+
+// The Minkowski sum of a and -b without building it: vertex k is a.v[i] +
+// b.neg_v[j] where i and j count the edges of each list among the first k of
+// the angle-ordered merge, found by binary search in O(log min(n, m)).
+struct minkowski_view {
+    const convex_shape& a;
+    const convex_shape& b;
+    unsigned long n;
+    unsigned long m;
+
+    minkowski_view(const convex_shape& a, const convex_shape& b)
+        : a(a), b(b), n(a.e.size()), m(b.neg_e.size()) {}
+
+    unsigned long size() const {
+        return n + m;
+    }
+
+    void at(unsigned long k, point& c, point& e) const {
+        k %= n + m;
+        unsigned long lo = k > m ? k - m : 0;
+        unsigned long hi = min(k, n);
+        while (lo < hi) {
+            unsigned long i = (lo + hi + 1) / 2;
+            if (edge_less(b.neg_e[k - i], a.e[i - 1])) {
+                hi = i - 1;
+            } else {
+                lo = i;
+            }
+        }
+        unsigned long j = k - lo;
+        c = a.v[lo % a.v.size()] + b.neg_v[j % b.neg_v.size()];
+        e = lo < n && (j == m || !edge_less(b.neg_e[j], a.e[lo])) ? a.e[lo] : b.neg_e[j];
+    }
+
+    point vertex(unsigned long k) const {
+        point c, e;
+        at(k, c, e);
+        return c;
+    }
+};
+
+// Distance from the origin to the line of edge k, positive when the origin
+// lies outside it.
+long double edge_gap(const point& c, const point& e) {
+    return pseudovec(e, c) / sqrt((long double) dot(e, e));
+}
+
+// Distance between two preprocessed shapes in O(log n log m). The origin is
+// located in the fan of the sum from vertex 0; if it is outside, this yields
+// an edge facing it. Over the edges facing the origin the gap is unimodal in
+// angle and they span less than 180 degrees, so the edge with the largest gap
+// is found by binary search from that edge, and the nearest point of the sum
+// lies on it.
+long double shape_dist(const convex_shape& a, const convex_shape& b) {
+    minkowski_view sum(a, b);
+    unsigned long total = sum.size();
+    point origin = {0, 0};
+    if (total == 0) {
+        return point_dist(origin, a.v[0] + b.neg_v[0]);
+    }
+    if (a.v.size() < 3 && b.v.size() < 3) {
+        segment s1 = {a.v[0], a.v.back()};
+        segment s2 = {b.v[0], b.v.back()};
+        if (intersect(s1.p1, s1.p2, s2.p1, s2.p2)) {
+            return 0;
+        }
+        return a.v.size() == 1 ? point_seg_dist(a.v[0], s2) : b.v.size() == 1 ? point_seg_dist(b.v[0], s1) : seg_seg_dist(s1, s2);
+    }
+    point c0 = sum.vertex(0);
+    point last, last_e, before, before_e;
+    sum.at(total - 1, last, last_e);
+    sum.at(total - 2, before, before_e);
+    unsigned long facing;
+    if (orientation({c0, sum.vertex(1)}, origin) < 0) {
+        facing = 0;
+    } else if (orientation({last, c0}, origin) < 0) {
+        facing = total - 1;
+    } else if (orientation({last, c0}, origin) == 0
+               && dot(last_e, vec({origin, same_direction(before_e, last_e) ? before : last})) > 0) {
+        // On the line of the closing edge, past it: the edge before that
+        // run (parallel edges of a and -b make a run of two) faces it.
+        facing = same_direction(before_e, last_e) ? total - 3 : total - 2;
+    } else {
+        unsigned long l = 1;
+        unsigned long r = total - 1;
+        while (l < r - 1) {
+            unsigned long mid = (l + r) / 2;
+            if (orientation({c0, sum.vertex(mid)}, origin) < 0) {
+                r = mid;
+            } else {
+                l = mid;
+            }
+        }
+        if (orientation({sum.vertex(l), sum.vertex(r)}, origin) >= 0) {
+            return 0;
+        }
+        facing = l;
+    }
+    point ce, ee;
+    sum.at(facing, ce, ee);
+    unsigned long best = facing;
+    for (int dir = 1; dir >= -1 && best == facing; dir -= 2) {
+        unsigned long step = dir > 0 ? 1 : total - 1;
+        auto rising = [&](unsigned long t) {
+            unsigned long k = (facing + t * step) % total;
+            point c, e, nc, ne;
+            sum.at(k, c, e);
+            long long turn = pseudovec(ee, e) * dir;
+            if (turn < 0 || (turn == 0 && !same_direction(ee, e)) || pseudovec(e, c) <= 0) {
+                return false;
+            }
+            unsigned long next = (k + step) % total;
+            sum.at(next, nc, ne);
+            if (same_direction(e, ne)) {
+                sum.at((next + step) % total, nc, ne);
+            }
+            return edge_gap(nc, ne) > edge_gap(c, e);
+        };
+        if (!rising(0)) {
+            continue;
+        }
+        unsigned long lo = 0;
+        unsigned long hi = total - 1;
+        while (lo < hi - 1) {
+            unsigned long mid = (lo + hi) / 2;
+            if (rising(mid)) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
         }
+        best = (facing + hi * step) % total;
+    }
+    long double res = numeric_limits<long double>::max();
+    for (unsigned long k = best + total - 1; k <= best + total + 1; k++) {
+        res = min(res, point_seg_dist(origin, {sum.vertex(k), sum.vertex(k + 1)}));
+    }
+    return res;
+}
+
+// All pairs of shapes at most d apart. Sweep and prune on x intervals widened
+// by d, then the y gap of the bounding boxes, then shape_dist() on the
+// remaining candidates split over threads. Per-phase counts go to stderr.
+vector<pair<pair<int, int>, long double>> close_pairs(const vector<convex_shape>& shapes, long double d, unsigned int threads) {
+    using clock = chrono::steady_clock;
+    auto t0 = clock::now();
+    int k = shapes.size();
+    vector<point> lo(k), hi(k);
+    for (int i = 0; i < k; i++) {
+        lo[i] = hi[i] = shapes[i].v[0];
+        for (const point& p : shapes[i].v) {
+            lo[i] = {min(lo[i].x, p.x), min(lo[i].y, p.y)};
+            hi[i] = {max(hi[i].x, p.x), max(hi[i].y, p.y)};
+        }
+    }
+    vector<int> order(k);
+    for (int i = 0; i < k; i++) {
+        order[i] = i;
+    }
+    sort(order.begin(), order.end(), [&](int a, int b) {
+        return lo[a].x < lo[b].x;
+    });
+    unsigned long long swept = 0;
+    vector<pair<int, int>> candidates;
+    for (int a = 0; a < k; a++) {
+        int i = order[a];
+        for (int b = a + 1; b < k && lo[order[b]].x - hi[i].x <= d; b++) {
+            int j = order[b];
+            swept++;
+            if (lo[j].y - hi[i].y <= d && lo[i].y - hi[j].y <= d) {
+                candidates.push_back({min(i, j), max(i, j)});
+            }
+        }
+    }
+    auto t1 = clock::now();
+    vector<long double> dist(candidates.size());
+    vector<thread> pool;
+    unsigned long chunk = (candidates.size() + threads - 1) / threads;
+    for (unsigned int t = 0; t < threads; t++) {
+        pool.emplace_back([&, t]() {
+            for (unsigned long c = t * chunk; c < min(candidates.size(), (t + 1) * chunk); c++) {
+                dist[c] = shape_dist(shapes[candidates[c].first], shapes[candidates[c].second]);
+            }
+        });
+    }
+    for (thread& th : pool) {
+        th.join();
+    }
+    vector<pair<pair<int, int>, long double>> res;
+    for (unsigned long c = 0; c < candidates.size(); c++) {
+        if (dist[c] <= d) {
+            res.push_back({candidates[c], dist[c]});
+        }
+    }
+    sort(res.begin(), res.end());
+    auto t2 = clock::now();
+    unsigned long long all = (unsigned long long) k * (k - 1) / 2;
+    cerr << "pairs " << all << ", sweep kept " << swept << " (removed " << all - swept << ")"
+         << ", boxes kept " << candidates.size() << " (removed " << swept - candidates.size() << ")"
+         << ", exact kept " << res.size() << " (removed " << candidates.size() - res.size() << ")" << endl;
+    cerr << "broad phase " << chrono::duration<double>(t1 - t0).count() << " s, exact phase "
+         << chrono::duration<double>(t2 - t1).count() << " s on " << threads << " threads" << endl;
+    return res;
+}
+
+// Hertel-Mehlhorn convex decomposition of a simple polygon from the
+// triangulation diagonals printed by i.cpp: a diagonal is dropped when both
+// of its ends stay convex without it, and the faces left are the pieces (at
+// most four times the optimal count).
+vector<vector<point>> convex_pieces(const vector<point>& poly, const vector<pair<int, int>>& diagonals) {
+    int n = poly.size();
+    long long area = 0;
+    for (int i = 0; i < n; i++) {
+        area += pseudovec(poly[i], poly[(i + 1) % n]);
+    }
+    vector<point> p(n);
+    for (int i = 0; i < n; i++) {
+        p[i] = area >= 0 ? poly[i] : poly[n - 1 - i];
+    }
+    auto index = [&](int i) {
+        return area >= 0 ? i : n - 1 - i;
+    };
+    // fan[v] holds (neighbour, diagonal or -1) counter-clockwise from the
+    // next vertex to the previous one.
+    vector<vector<pair<int, int>>> fan(n);
+    for (int v = 0; v < n; v++) {
+        fan[v].push_back({(v + 1) % n, -1});
+    }
+    for (unsigned long d = 0; d < diagonals.size(); d++) {
+        int u = index(diagonals[d].first);
+        int v = index(diagonals[d].second);
+        fan[u].push_back({v, (int) d});
+        fan[v].push_back({u, (int) d});
+    }
+    for (int v = 0; v < n; v++) {
+        fan[v].push_back({(v + n - 1) % n, -1});
+        point ref = vec({p[v], p[(v + 1) % n]});
+        auto half = [&](const point& a) {
+            long long c = pseudovec(ref, a);
+            return c < 0 || (c == 0 && dot(ref, a) < 0);
+        };
+        sort(fan[v].begin() + 1, fan[v].end() - 1, [&](const pair<int, int>& x, const pair<int, int>& y) {
+            point a = vec({p[v], p[x.first]});
+            point b = vec({p[v], p[y.first]});
+            if (half(a) != half(b)) {
+                return half(b);
+            }
+            return pseudovec(a, b) > 0;
+        });
+    }
+    vector<bool> kept(diagonals.size(), true);
+    auto convex_without = [&](int v, int d) {
+        int k = 0;
+        while (fan[v][k].second != d) {
+            k++;
+        }
+        int before = k - 1;
+        while (fan[v][before].second >= 0 && !kept[fan[v][before].second]) {
+            before--;
+        }
+        int after = k + 1;
+        while (fan[v][after].second >= 0 && !kept[fan[v][after].second]) {
+            after++;
+        }
+        return pseudovec(vec({p[v], p[fan[v][before].first]}), vec({p[v], p[fan[v][after].first]})) >= 0;
+    };
+    for (unsigned long d = 0; d < diagonals.size(); d++) {
+        if (convex_without(index(diagonals[d].first), d) && convex_without(index(diagonals[d].second), d)) {
+            kept[d] = false;
+        }
+    }
+    for (int v = 0; v < n; v++) {
+        fan[v].erase(remove_if(fan[v].begin(), fan[v].end(), [&](const pair<int, int>& x) {
+            return x.second >= 0 && !kept[x.second];
+        }), fan[v].end());
+    }
+    // Walk every face counter-clockwise: arriving at w from u, leave along
+    // the neighbour just before u in w's fan.
+    vector<vector<bool>> used(n);
+    for (int v = 0; v < n; v++) {
+        used[v].assign(fan[v].size(), false);
+        used[v].back() = true;
+    }
+    vector<vector<point>> pieces;
+    for (int v = 0; v < n; v++) {
+        for (unsigned long k = 0; k < fan[v].size(); k++) {
+            if (used[v][k]) {
+                continue;
+            }
+            vector<point> piece;
+            int u = v;
+            unsigned long e = k;
+            while (!used[u][e]) {
+                used[u][e] = true;
+                piece.push_back(p[u]);
+                int w = fan[u][e].first;
+                unsigned long back = 0;
+                while (fan[w][back].first != u) {
+                    back++;
+                }
+                u = w;
+                e = back - 1;
+            }
+            pieces.push_back(piece);
+        }
+    }
+    return pieces;
+}
+
+// Distance between two simple polygons: a plus -b is the union of the convex
+// sums of their pieces, and the origin's distance to that union is the
+// smallest distance to any of them. Piece pairs are taken in order of their
+// bounding-box gap, a lower bound on the sum's distance, and stop once it
+// exceeds the best found; workers pull batches of them and merge each pair
+// with convex_sum().
+long double nonconvex_dist(const vector<vector<point>>& pa, const vector<vector<point>>& pb, unsigned int threads) {
+    vector<convex_shape> sa, sb;
+    for (const vector<point>& piece : pa) {
+        sa.push_back(make_shape(piece));
+    }
+    for (const vector<point>& piece : pb) {
+        sb.push_back(make_shape(piece));
+    }
+    auto box = [](const convex_shape& s, point& lo, point& hi) {
+        lo = hi = s.v[0];
+        for (const point& p : s.v) {
+            lo = {min(lo.x, p.x), min(lo.y, p.y)};
+            hi = {max(hi.x, p.x), max(hi.y, p.y)};
+        }
+    };
+    vector<point> lo_a(sa.size()), hi_a(sa.size()), lo_b(sb.size()), hi_b(sb.size());
+    for (unsigned long i = 0; i < sa.size(); i++) {
+        box(sa[i], lo_a[i], hi_a[i]);
+    }
+    for (unsigned long j = 0; j < sb.size(); j++) {
+        box(sb[j], lo_b[j], hi_b[j]);
+    }
+    auto gap = [&](int i, int j) {
+        long double dx = max(0LL, max(lo_b[j].x - hi_a[i].x, lo_a[i].x - hi_b[j].x));
+        long double dy = max(0LL, max(lo_b[j].y - hi_a[i].y, lo_a[i].y - hi_b[j].y));
+        return sqrt(dx * dx + dy * dy);
+    };
+    auto exact = [&](int i, int j) {
+        if (sa[i].v.size() < 3 || sb[j].v.size() < 3) {
+            return shape_dist(sa[i], sb[j]);
+        }
+        vector<point> sum = convex_sum(sa[i].v, sb[j].neg_v);
+        point origin = {0, 0};
+        return min_dist(origin, sum);
+    };
+    // Seed the bound with the nearest-looking pair, then keep only pairs
+    // whose boxes come within it: a sweep on x, then the box gap.
+    int j0 = 0;
+    for (unsigned long j = 0; j < sb.size(); j++) {
+        if (gap(0, j) < gap(0, j0)) {
+            j0 = j;
+        }
+    }
+    int i0 = 0;
+    for (unsigned long i = 0; i < sa.size(); i++) {
+        if (gap(i, j0) < gap(i0, j0)) {
+            i0 = i;
+        }
+    }
+    long double best = exact(i0, j0);
+    auto by_left = [](const vector<point>& lo) {
+        vector<int> order(lo.size());
+        for (unsigned long i = 0; i < lo.size(); i++) {
+            order[i] = i;
+        }
+        sort(order.begin(), order.end(), [&](int x, int y) {
+            return lo[x].x < lo[y].x;
+        });
+        return order;
+    };
+    vector<int> order_a = by_left(lo_a), order_b = by_left(lo_b);
+    // Each pair whose x ranges come within best is met once, from the box
+    // that starts further left (a on ties): it scans the other list from
+    // its own left end until the other boxes start more than best past it.
+    vector<pair<long double, pair<int, int>>> candidates;
+    unsigned long long swept = 0;
+    auto keep = [&](int i, int j) {
+        swept++;
+        long double g = gap(i, j);
+        if (g <= best) {
+            candidates.push_back({g, {i, j}});
+        }
+    };
+    unsigned long first = 0;
+    for (int i : order_a) {
+        while (first < order_b.size() && lo_b[order_b[first]].x < lo_a[i].x) {
+            first++;
+        }
+        for (unsigned long k = first; k < order_b.size() && lo_b[order_b[k]].x - hi_a[i].x <= best; k++) {
+            keep(i, order_b[k]);
+        }
+    }
+    first = 0;
+    for (int j : order_b) {
+        while (first < order_a.size() && lo_a[order_a[first]].x <= lo_b[j].x) {
+            first++;
+        }
+        for (unsigned long k = first; k < order_a.size() && lo_a[order_a[k]].x - hi_b[j].x <= best; k++) {
+            keep(order_a[k], j);
+        }
+    }
+    sort(candidates.begin(), candidates.end());
+    const unsigned long batch = 8;
+    atomic<unsigned long> cursor(0);
+    atomic<unsigned long> built(1);
+    mutex best_lock;
+    vector<thread> pool;
+    for (unsigned int t = 0; t < threads; t++) {
+        pool.emplace_back([&]() {
+            while (true) {
+                unsigned long c = cursor.fetch_add(batch);
+                if (c >= candidates.size()) {
+                    return;
+                }
+                long double local;
+                {
+                    lock_guard<mutex> guard(best_lock);
+                    local = best;
+                }
+                if (local == 0 || candidates[c].first > local) {
+                    return;
+                }
+                for (unsigned long k = c; k < min(candidates.size(), c + batch); k++) {
+                    if (candidates[k].first <= local) {
+                        local = min(local, exact(candidates[k].second.first, candidates[k].second.second));
+                        built++;
+                    }
+                }
+                lock_guard<mutex> guard(best_lock);
+                best = min(best, local);
+            }
+        });
+    }
+    for (thread& th : pool) {
+        th.join();
+    }
+    cerr << "pieces " << sa.size() << " x " << sb.size() << ", pairs " << sa.size() * sb.size()
+         << ", x sweep kept " << swept << ", within box bound " << candidates.size() << ", sums built " << built << endl;
+    return best;
+}
+
+vector<point> read_polygon() {
+    int n;
+    cin >> n;
+    vector<point> a(n);
+    for (int i = 0; i < n; i++) {
+        long long x, y;
+        cin >> x >> y;
+        a[i] = {x, y};
+    }
+    return a;
+}
+
+// Reads k polygons, then q pairs of 0-based polygon indices, and prints the
+// distance for every pair.
+void run_queries() {
+    int k;
+    cin >> k;
+    vector<convex_shape> shapes;
+    shapes.reserve(k);
+    for (int i = 0; i < k; i++) {
+        shapes.push_back(make_shape(read_polygon()));
+    }
+    int q;
+    cin >> q;
+    cout << fixed << setprecision(20);
+    for (int i = 0; i < q; i++) {
+        int x, y;
+        cin >> x >> y;
+        cout << shape_dist(shapes[x], shapes[y]) << "\n";
+    }
+}
+
+// k random convex polygons of about n vertices each; q random pairs are
+// answered by the query engine and by the full Minkowski sum.
+void bench(int k, int n, int q) {
+    using clock = chrono::steady_clock;
+    mt19937_64 rnd(n);
+    uniform_real_distribution<double> angle(0, 2 * pi);
+    uniform_int_distribution<long long> center(-100000000, 100000000);
+    uniform_int_distribution<long long> radius(1000000, 50000000);
+    vector<vector<point>> polys(k);
+    vector<convex_shape> shapes;
+    for (vector<point>& poly : polys) {
+        point c = {center(rnd), center(rnd)};
+        long long r = radius(rnd);
+        vector<point> pts(n);
+        for (point& p : pts) {
+            long double t = angle(rnd);
+            p = {c.x + (long long) (r * cosl(t)), c.y + (long long) (r * sinl(t))};
+        }
+        convex_shape s = make_shape(pts);
+        poly.assign(s.v.rbegin(), s.v.rend());
+        shapes.push_back(s);
+    }
+    vector<pair<int, int>> pairs(q);
+    uniform_int_distribution<int> pick(0, k - 1);
+    for (auto& pr : pairs) {
+        pr = {pick(rnd), pick(rnd)};
+    }
+    vector<long double> fast(q), slow(q);
+    auto t0 = clock::now();
+    for (int i = 0; i < q; i++) {
+        fast[i] = shape_dist(shapes[pairs[i].first], shapes[pairs[i].second]);
+    }
+    auto t1 = clock::now();
+    for (int i = 0; i < q; i++) {
+        slow[i] = minkowski_dist(polys[pairs[i].first], polys[pairs[i].second]);
+    }
+    auto t2 = clock::now();
+    long double diff = 0;
+    for (int i = 0; i < q; i++) {
+        diff = max(diff, abs(fast[i] - slow[i]));
+    }
+    cout << "polygons " << k << " x " << n << " points, queries " << q << ", max difference " << diff << "\n";
+    cout << "engine " << q / chrono::duration<double>(t1 - t0).count() << " queries/s\n";
+    cout << "minkowski " << q / chrono::duration<double>(t2 - t1).count() << " queries/s\n";
+}
+
+// Reads k polygons and prints every pair at most d apart as "i j distance".
+void run_pairs(long double d, unsigned int threads) {
+    int k;
+    cin >> k;
+    vector<convex_shape> shapes;
+    shapes.reserve(k);
+    for (int i = 0; i < k; i++) {
+        shapes.push_back(make_shape(read_polygon()));
+    }
+    vector<pair<pair<int, int>, long double>> res = close_pairs(shapes, d, threads);
+    cout << res.size() << "\n" << fixed << setprecision(20);
+    for (const auto& r : res) {
+        cout << r.first.first << " " << r.first.second << " " << r.second << "\n";
+    }
+}
+
+// Reads a simple polygon followed by the n - 3 diagonals i.cpp prints for it.
+vector<vector<point>> read_pieces() {
+    vector<point> poly = read_polygon();
+    vector<pair<int, int>> diagonals(max(0, (int) poly.size() - 3));
+    for (auto& d : diagonals) {
+        cin >> d.first >> d.second;
+    }
+    return convex_pieces(poly, diagonals);
+}
+
+int main(int argc, char* argv[]) {
+    string mode = argc > 1 ? argv[1] : "";
+    if (mode == "nonconvex") {
+        unsigned int threads = argc > 2 ? max(1, atoi(argv[2])) : max(1u, thread::hardware_concurrency());
+        vector<vector<point>> a = read_pieces();
+        vector<vector<point>> b = read_pieces();
+        cout << fixed << setprecision(20) << nonconvex_dist(a, b, threads);
+        return 0;
+    }
+    if (mode == "pairs") {
+        unsigned int threads = argc > 3 ? max(1, atoi(argv[3])) : max(1u, thread::hardware_concurrency());
+        run_pairs(argc > 2 ? strtold(argv[2], nullptr) : 0, threads);
+        return 0;
+    }
+    if (mode == "queries") {
+        run_queries();
+        return 0;
+    }
+    if (mode == "bench") {
+        bench(argc > 2 ? atoi(argv[2]) : 1000, argc > 3 ? atoi(argv[3]) : 1000, argc > 4 ? atoi(argv[4]) : 100000);
+        return 0;
     }
-    cout << fixed << setprecision(20) << min_dist(start, sum);
+    vector<point> a = read_polygon();
+    vector<point> b = read_polygon();
+    cout << fixed << setprecision(20) << minkowski_dist(a, b);
     return 0;
 }
\ No newline at end of file
@@ -2,7 +2,16 @@
 #include <vector>
 #include <algorithm>
 #include <set>
+#include <map>
 #include <cmath>
+#include <limits>
+#include <string>
+#include <iomanip>
+#include <thread>
+#include <cstdlib>
+#include <atomic>
+#include <mutex>
+#include <chrono>
 
 using namespace std;
 
@@ -21,61 +30,162 @@ struct segment {
     point p2;
 };
 
-struct event {
+// Endpoint event of the detection sweep: x with the sign bit flipped so it
+// orders as unsigned, and the slab-local segment index shifted left by one
+// with the low bit set for an end.
+struct compact_event {
+    unsigned long long x;
+    unsigned int code;
+};
+
+const long double eps = 1e-10;
+
+const unsigned long long x_flip = 1ULL << 63;
+const int radix_bits = 11;
+
+// Stable LSD radix sort on x, skipping the digits on which all keys agree.
+void radix_sort(vector<compact_event>& events) {
+    if (events.empty()) {
+        return;
+    }
+    unsigned long long differ = 0;
+    for (const compact_event& e : events) {
+        differ |= e.x ^ events[0].x;
+    }
+    const unsigned long long digit = (1ULL << radix_bits) - 1;
+    vector<compact_event> buf(events.size());
+    vector<unsigned long> count(digit + 2);
+    for (int shift = 0; shift < 64; shift += radix_bits) {
+        if ((differ >> shift & digit) == 0) {
+            continue;
+        }
+        fill(count.begin(), count.end(), 0);
+        for (const compact_event& e : events) {
+            count[(e.x >> shift & digit) + 1]++;
+        }
+        for (unsigned long d = 1; d < count.size(); d++) {
+            count[d] += count[d - 1];
+        }
+        for (const compact_event& e : events) {
+            buf[count[e.x >> shift & digit]++] = e;
+        }
+        events.swap(buf);
+    }
+}
+
+// Exact point with rational coordinates x / d, y / d and d > 0. Exact for
+// input coordinates up to 10^7 in absolute value.
+struct ratio_point {
+    __int128 x;
+    __int128 y;
+    __int128 d;
+};
+
+struct ratio_comp {
+    bool operator()(const ratio_point& a, const ratio_point& b) const {
+        __int128 l = a.x * b.d;
+        __int128 r = b.x * a.d;
+        if (l != r) {
+            return l < r;
+        }
+        return a.y * b.d < b.y * a.d;
+    }
+};
+
+// Sweep-status entry: the segment, its id and its y at the sweep position,
+// cached together with the epoch of the position it was computed for.
+struct status_entry {
     segment s;
     int n;
+    mutable unsigned int den;
+    mutable unsigned long epoch;
+    mutable __int128 num;
 };
 
-struct full_event {
-    event e;
-    bool isStart;
-};
+// Position of one sweep. Each move starts a new epoch, so an entry's y is
+// computed once per event and a comparison just cross-multiplies two cached
+// keys. Every sweep owns its state, so sweeps can run side by side.
+struct sweep_state {
+    ratio_point at = {0, 0, 1};
+    unsigned long epoch = 1;
+    // Verticals take the sweep point's y clamped to the segment, or else the
+    // y of their first point.
+    bool clamp_verticals;
 
-long double t = -10001;
+    void move_to(const ratio_point& p) {
+        at = p;
+        epoch++;
+    }
 
-const long double eps = 1e-10;
+    bool ends_here(const segment& s) const {
+        return s.p2.x * at.d == at.x;
+    }
 
-struct event_sort_comp {
-    bool operator ()(const full_event& a, const full_event& b) const {
-        point f = a.isStart ? a.e.s.p1 : a.e.s.p2;
-        point s = b.isStart ? b.e.s.p1 : b.e.s.p2;
-        long long dt = f.x - s.x;
-        if (dt == 0) {
-            if (a.isStart) {
-                return true;
-            }
-            return false;
+    bool at_point(const point& p) const {
+        return p.x * at.d == at.x && p.y * at.d == at.y;
+    }
+
+    // Fills e.num and e.den with its y at the sweep position, which is
+    // e.num / (e.den * at.d); e.den is the x extent, which fits 32 bits for
+    // coordinates below 2^31. The probe entry (n == 0) takes the position's y.
+    const status_entry& key(const status_entry& e) const {
+        if (e.epoch == epoch) {
+            return e;
+        }
+        e.epoch = epoch;
+        long long dx = e.s.p2.x - e.s.p1.x;
+        e.den = 1;
+        if (e.n == 0) {
+            e.num = at.y;
+        } else if (dx == 0) {
+            e.num = clamp_verticals ? min(max(at.y, (__int128) e.s.p1.y * at.d), (__int128) e.s.p2.y * at.d) : e.s.p1.y * at.d;
+        } else {
+            e.num = (__int128) e.s.p1.y * dx * at.d + (__int128) (e.s.p2.y - e.s.p1.y) * (at.x - (__int128) e.s.p1.x * at.d);
+            e.den = dx;
         }
-        return dt < 0;
+        return e;
     }
-};
 
-long double getPointYNow(const event& a) {
-    if (abs(a.s.p1.x - a.s.p2.x) < eps) {
-        return a.s.p1.y;
+    // Sign of y(a) - y(b) at the sweep position; a 64 by 64 bit multiply
+    // when both keys fit, as they do for integer sweep positions.
+    int compare_y(const status_entry& a, const status_entry& b) const {
+        key(a);
+        key(b);
+        __int128 l, r;
+        if ((long long) a.num == a.num && (long long) b.num == b.num) {
+            l = (__int128) (long long) a.num * b.den;
+            r = (__int128) (long long) b.num * a.den;
+        } else {
+            l = a.num * b.den;
+            r = b.num * a.den;
+        }
+        return l < r ? -1 : l > r ? 1 : 0;
     }
-    return a.s.p1.y + (a.s.p2.y - a.s.p1.y) * (t - a.s.p1.x) / (a.s.p2.x - a.s.p1.x);
-}
+};
 
+// exist() order: y at the sweep x, then segments ending there above the
+// others, then id.
 struct event_set_comp {
-    bool operator()(const event& a, const event& b) const {
-        long double f_y = getPointYNow(a);
-        long double s_y = getPointYNow(b);
-        if (abs(f_y - s_y) < eps) {
-            if (t == b.s.p2.x) {
-                if (t == a.s.p2.x) {
+    const sweep_state* sweep;
+
+    bool operator()(const status_entry& a, const status_entry& b) const {
+        int y = sweep->compare_y(a, b);
+        if (y == 0) {
+            if (sweep->ends_here(b.s)) {
+                if (sweep->ends_here(a.s)) {
                     return a.n < b.n;
                 }
                 return true;
             }
-            if (t == a.s.p2.x) {
+            if (sweep->ends_here(a.s)) {
                 return false;
             }
             return a.n < b.n;
         }
-        return f_y < s_y - eps;
+        return y < 0;
     };
 };
+
 bool between(const segment& s, const point& p) {
     const long double& lx = min(s.p1.x, s.p2.x);
     const long double& rx = max(s.p1.x, s.p2.x);
@@ -172,83 +282,341 @@ bool intersect_segments(const segment& s1, const segment& s2) {
     return min(min(point_seg_dist(s1.p1, s2), point_seg_dist(s1.p2, s2)), min(point_seg_dist(s2.p1, s1), point_seg_dist(s2.p2, s1))) < eps;
 }
 
-vector<int> exist(vector<segment>& segments) {
-    int n = segments.size();
-    vector<full_event> sorted;
-    for (int i = 0; i < n; i++) {
-        event ev = {segments[i], i + 1};
-        sorted.push_back({ev, false});
-        sorted.push_back({ev, true});
-    }
-    event_sort_comp comp;
-    stable_sort(sorted.begin(), sorted.end(), comp);
-
-    set<event, event_set_comp> line;
-    vector<set<event>::iterator> pos(n);
-    for (int i = 0; i < 2 * n; i++) {
-        event cur = sorted[i].e;
-        t = sorted[i].isStart ? cur.s.p1.x : cur.s.p2.x;
-        if (sorted[i].isStart) {
-            auto it = line.insert(cur).first;
-            pos[cur.n - 1] = it;
+// Ids of the first intersecting pair the sweep over the slab lo <= x <= hi
+// meets, or nothing. Segments reaching past the slab are clipped to it: their
+// events move to the boundary while their keys still come from the full
+// line. Keeps all sweep state local, so independent calls can run
+// concurrently; gives up early once stop is set.
+vector<int> first_intersection(const vector<segment>& segments, long long lo, long long hi, const atomic<bool>& stop) {
+    vector<int> ids;
+    for (unsigned int i = 0; i < segments.size(); i++) {
+        if (segments[i].p2.x >= lo && segments[i].p1.x <= hi) {
+            ids.push_back(i);
+        }
+    }
+    // Starts come before ends and both follow ids, so the stable sort leaves
+    // events ordered by x, then starts first, then input order.
+    unsigned int m = ids.size();
+    vector<compact_event> events(2 * m);
+    for (unsigned int i = 0; i < m; i++) {
+        const segment& s = segments[ids[i]];
+        events[i] = {(unsigned long long) max(s.p1.x, lo) ^ x_flip, i << 1};
+        events[m + i] = {(unsigned long long) min(s.p2.x, hi) ^ x_flip, i << 1 | 1};
+    }
+    radix_sort(events);
+
+    sweep_state sweep;
+    sweep.clamp_verticals = false;
+    set<status_entry, event_set_comp> line(event_set_comp{&sweep});
+    vector<set<status_entry>::iterator> pos(m);
+    for (unsigned long i = 0; i < events.size(); i++) {
+        if (i % 4096 == 0 && stop.load(memory_order_relaxed)) {
+            return {};
+        }
+        unsigned int local = events[i].code >> 1;
+        int id = ids[local] + 1;
+        // Keys and tests use the unclipped segment.
+        const segment& cur = segments[id - 1];
+        sweep.move_to({(long long) (events[i].x ^ x_flip), 0, 1});
+        if (!(events[i].code & 1)) {
+            auto it = line.insert({cur, id, 1, 0, 0}).first;
+            pos[local] = it;
             if (it != line.begin()) {
                 auto prev_it = prev(it);
-                if (intersect_segments(prev_it->s, cur.s)) {
-                    cout << "YES" << endl;
-                    cout << prev_it->n << " " << cur.n << endl;
-                    int f = prev_it->n;
-                    int s = cur.n;
-                    vector<int> res;
-                    res.push_back(f);
-                    res.push_back(s);
-                    line.clear();
-                    return res;
+                if (intersect_segments(prev_it->s, cur)) {
+                    return {prev_it->n, id};
                 }
             }
             auto next_it = next(it);
             if (next_it != line.end()) {
-                if (intersect_segments(next_it->s, cur.s)) {
-                    cout << "YES" << endl;
-                    cout << next_it->n << " " << cur.n << endl;
-                    int f = next_it->n;
-                    int s = cur.n;
-                    vector<int> res;
-                    res.push_back(f);
-                    res.push_back(s);
-                    line.clear();
-                    return res;
+                if (intersect_segments(next_it->s, cur)) {
+                    return {next_it->n, id};
                 }
             }
         } else {
-            auto it = pos[cur.n - 1];
+            auto it = pos[local];
             if (it != line.begin()) {
                 auto prev_it = prev(it);
                 if (it != line.end()) {
                     auto next_it = next(it);
                     if (next_it != line.end()) {
                         if (intersect_segments(prev_it->s, next_it->s)) {
-                            cout << "YES" << endl;
-                            cout << prev_it->n << " " << next_it->n << endl;
-                            int f = prev_it->n;
-                            int s = next_it->n;
-                            vector<int> res;
-                            res.push_back(f);
-                            res.push_back(s);
-                            line.clear();
-                            return res;
+                            return {prev_it->n, next_it->n};
                         }
                     }
                 }
             }
-            line.erase(pos[cur.n - 1]);
+            line.erase(it);
         }
     }
-    line.clear();
-    cout << "NO" << endl;
     return {};
 }
 
-int main() {
+vector<int> first_intersection(const vector<segment>& segments) {
+    atomic<bool> stop(false);
+    return first_intersection(segments, numeric_limits<long long>::min(), numeric_limits<long long>::max(), stop);
+}
+
+// Splits the x range into slabs holding about the same number of endpoints
+// and sweeps them on separate threads. An intersection lies in some slab, and
+// every pair a slab reports is a real one, so the first hit cancels the rest.
+// A segment is swept in every slab it reaches, so long segments are repeated
+// across slabs and limit the speedup; the copy count goes to stderr.
+vector<int> slab_intersection(const vector<segment>& segments, unsigned int threads) {
+    using clock = chrono::steady_clock;
+    auto t0 = clock::now();
+    vector<long long> xs;
+    xs.reserve(2 * segments.size());
+    for (const segment& s : segments) {
+        xs.push_back(s.p1.x);
+        xs.push_back(s.p2.x);
+    }
+    vector<long long> bounds = {numeric_limits<long long>::min()};
+    for (unsigned int k = 1; k < threads && !xs.empty(); k++) {
+        auto it = xs.begin() + xs.size() * k / threads;
+        nth_element(xs.begin(), it, xs.end());
+        if (*it > bounds.back()) {
+            bounds.push_back(*it);
+        }
+    }
+    bounds.push_back(numeric_limits<long long>::max());
+    unsigned int slabs = bounds.size() - 1;
+    unsigned long long copies = 0;
+    for (const segment& s : segments) {
+        copies += upper_bound(bounds.begin() + 1, bounds.end() - 1, s.p2.x) - lower_bound(bounds.begin() + 1, bounds.end() - 1, s.p1.x) + 1;
+    }
+
+    atomic<bool> stop(false);
+    mutex found_lock;
+    vector<int> found;
+    vector<double> took(slabs);
+    vector<thread> pool;
+    for (unsigned int k = 0; k < slabs; k++) {
+        pool.emplace_back([&, k]() {
+            auto start = clock::now();
+            vector<int> res = first_intersection(segments, bounds[k], bounds[k + 1], stop);
+            took[k] = chrono::duration<double>(clock::now() - start).count();
+            if (!res.empty()) {
+                lock_guard<mutex> guard(found_lock);
+                if (found.empty()) {
+                    found = res;
+                }
+                stop = true;
+            }
+        });
+    }
+    for (thread& th : pool) {
+        th.join();
+    }
+    cerr << "slabs " << slabs << ", segment copies " << copies << " of " << segments.size() << ", sweep times";
+    for (double t : took) {
+        cerr << " " << t;
+    }
+    cerr << " s, total " << chrono::duration<double>(clock::now() - t0).count() << " s" << endl;
+    return found;
+}
+
+void print_first(const vector<int>& res) {
+    if (res.empty()) {
+        cout << "NO" << endl;
+    } else {
+        cout << "YES" << endl;
+        cout << res[0] << " " << res[1] << endl;
+    }
+}
+
+vector<int> exist(vector<segment>& segments) {
+    vector<int> res = first_intersection(segments);
+    print_first(res);
+    return res;
+}
+
+point_d to_point_d(const ratio_point& p) {
+    return {(long double) p.x / (long double) p.d, (long double) p.y / (long double) p.d};
+}
+
+// Slope order with verticals last.
+int compare_slope(const segment& a, const segment& b) {
+    long long dxa = a.p2.x - a.p1.x;
+    long long dxb = b.p2.x - b.p1.x;
+    if (dxa == 0 || dxb == 0) {
+        return (dxa == 0) - (dxb == 0);
+    }
+    __int128 l = (__int128) (a.p2.y - a.p1.y) * dxb;
+    __int128 r = (__int128) (b.p2.y - b.p1.y) * dxa;
+    return l < r ? -1 : l > r ? 1 : 0;
+}
+
+// Order of the sweep status just past the sweep point: by y there, then by
+// slope, then by id. The probe (n == 0) ties with every segment through the
+// sweep point, so equal_range-style scans find them.
+struct sweep_comp {
+    const sweep_state* sweep;
+
+    bool operator()(const status_entry& a, const status_entry& b) const {
+        if (a.n == b.n) {
+            return false;
+        }
+        int y = sweep->compare_y(a, b);
+        if (y != 0) {
+            return y < 0;
+        }
+        if (a.n == 0 || b.n == 0) {
+            return false;
+        }
+        int slope = compare_slope(a.s, b.s);
+        if (slope != 0) {
+            return slope < 0;
+        }
+        return a.n < b.n;
+    }
+};
+
+// The point where a and b meet, if they are not parallel and meet at all.
+bool crossing_point(const segment& a, const segment& b, ratio_point& q) {
+    point da = vec(a);
+    point db = vec(b);
+    point ab = {b.p1.x - a.p1.x, b.p1.y - a.p1.y};
+    __int128 den = (__int128) da.x * db.y - (__int128) da.y * db.x;
+    if (den == 0) {
+        return false;
+    }
+    __int128 ta = (__int128) ab.x * db.y - (__int128) ab.y * db.x;
+    __int128 tb = (__int128) ab.x * da.y - (__int128) ab.y * da.x;
+    if (den < 0) {
+        den = -den;
+        ta = -ta;
+        tb = -tb;
+    }
+    if (ta < 0 || ta > den || tb < 0 || tb > den) {
+        return false;
+    }
+    q = {a.p1.x * den + da.x * ta, a.p1.y * den + da.y * ta, den};
+    return true;
+}
+
+// One reported intersection: the segments (1-based ids, ascending) through
+// point p, or two collinear segments overlapping from p to q.
+struct intersection {
+    point_d p;
+    point_d q;
+    vector<int> ids;
+    bool overlap;
+};
+
+// Event queue entry: segments starting here, whether some segment ends here,
+// and how many currently adjacent pairs of the status cross here. A crossing
+// is dropped once no adjacent pair refers to it, so the queue stays O(n).
+struct queue_entry {
+    vector<int> starts;
+    bool endpoint = false;
+    int pairs = 0;
+};
+
+// Bentley-Ottmann: reports every intersection point with all segments through
+// it, and every overlap of collinear segments, to report() in sweep order,
+// in O((n + k) log n) time and O(n) memory.
+template <typename Report>
+void report_intersections(vector<segment> segments, Report report) {
+    int n = segments.size();
+    map<ratio_point, queue_entry, ratio_comp> queue;
+    for (int i = 0; i < n; i++) {
+        segment& s = segments[i];
+        if (s.p2.x < s.p1.x || (s.p2.x == s.p1.x && s.p2.y < s.p1.y)) {
+            swap(s.p1, s.p2);
+        }
+        queue_entry& start = queue[{s.p1.x, s.p1.y, 1}];
+        start.starts.push_back(i + 1);
+        start.endpoint = true;
+        queue[{s.p2.x, s.p2.y, 1}].endpoint = true;
+    }
+    sweep_state sweep;
+    sweep.clamp_verticals = true;
+    sweep_comp comp{&sweep};
+    set<status_entry, sweep_comp> line(comp);
+    ratio_comp before;
+    auto pair_changed = [&](set<status_entry>::iterator below, set<status_entry>::iterator above, int delta) {
+        ratio_point q;
+        if (below == line.end() || above == line.end() || !crossing_point(below->s, above->s, q) || !before(sweep.at, q)) {
+            return;
+        }
+        if (delta > 0) {
+            queue[q].pairs++;
+            return;
+        }
+        auto it = queue.find(q);
+        if (it != queue.end() && --it->second.pairs == 0 && !it->second.endpoint) {
+            queue.erase(it);
+        }
+    };
+    const status_entry probe = {{}, 0, 1, 0, 0};
+    auto through = [&](set<status_entry>::iterator& first, set<status_entry>::iterator& last) {
+        first = line.lower_bound(probe);
+        last = first;
+        while (last != line.end() && !comp(probe, *last)) {
+            last++;
+        }
+    };
+    while (!queue.empty()) {
+        sweep.move_to(queue.begin()->first);
+        vector<int> starts = move(queue.begin()->second.starts);
+        queue.erase(queue.begin());
+
+        set<status_entry>::iterator first, last;
+        through(first, last);
+        set<status_entry>::iterator below = first == line.begin() ? line.end() : prev(first);
+        if (first != last) {
+            pair_changed(below, first, -1);
+            pair_changed(prev(last), last, -1);
+        } else {
+            pair_changed(below, last, -1);
+        }
+        vector<status_entry> passing(first, last);
+        line.erase(first, last);
+
+        vector<int> ids;
+        for (const status_entry& e : passing) {
+            ids.push_back(e.n);
+        }
+        ids.insert(ids.end(), starts.begin(), starts.end());
+        if (ids.size() > 1) {
+            sort(ids.begin(), ids.end());
+            report(intersection{to_point_d(sweep.at), {}, ids, false});
+        }
+
+        for (const status_entry& e : passing) {
+            if (!sweep.at_point(e.s.p2)) {
+                line.insert(e);
+            }
+        }
+        for (int id : starts) {
+            if (!sweep.at_point(segments[id - 1].p2)) {
+                line.insert({segments[id - 1], id, 1, 0, 0});
+            }
+        }
+        through(first, last);
+        // Collinear segments through the point are adjacent; an overlap is
+        // reported where the later of the two starts.
+        for (auto a = first; a != last; a++) {
+            for (auto b = next(a); b != last && compare_slope(a->s, b->s) == 0; b++) {
+                if (sweep.at_point(a->s.p1) || sweep.at_point(b->s.p1)) {
+                    point end = ratio_comp()({a->s.p2.x, a->s.p2.y, 1}, {b->s.p2.x, b->s.p2.y, 1}) ? a->s.p2 : b->s.p2;
+                    vector<int> pair_ids = {min(a->n, b->n), max(a->n, b->n)};
+                    report(intersection{to_point_d(sweep.at), {(long double) end.x, (long double) end.y}, pair_ids, true});
+                }
+            }
+        }
+        below = first == line.begin() ? line.end() : prev(first);
+        if (first != last) {
+            pair_changed(below, first, 1);
+            pair_changed(prev(last), last, 1);
+        } else {
+            pair_changed(below, last, 1);
+        }
+    }
+}
+
+vector<segment> read_segments() {
     int n;
     cin >> n;
     vector<segment> segments(n);
@@ -260,6 +628,61 @@ int main() {
         }
         segments[i] = s;
     }
+    return segments;
+}
+
+// Reads l independent layers of segments and runs their sweeps concurrently,
+// printing each layer's answer as exist() does, in input order.
+void run_layers(unsigned int threads) {
+    int l;
+    cin >> l;
+    vector<vector<segment>> layers(l);
+    for (auto& layer : layers) {
+        layer = read_segments();
+    }
+    vector<vector<int>> res(l);
+    vector<thread> pool;
+    for (unsigned int t = 0; t < threads; t++) {
+        pool.emplace_back([&, t]() {
+            for (int i = t; i < l; i += threads) {
+                res[i] = first_intersection(layers[i]);
+            }
+        });
+    }
+    for (thread& th : pool) {
+        th.join();
+    }
+    for (const vector<int>& r : res) {
+        print_first(r);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    string mode = argc > 1 ? argv[1] : "";
+    if (mode == "layers") {
+        run_layers(argc > 2 ? max(1, atoi(argv[2])) : max(1u, thread::hardware_concurrency()));
+        return 0;
+    }
+    vector<segment> segments = read_segments();
+    if (mode == "slabs") {
+        print_first(slab_intersection(segments, argc > 2 ? max(1, atoi(argv[2])) : max(1u, thread::hardware_concurrency())));
+        return 0;
+    }
+    if (mode == "all") {
+        cout << fixed << setprecision(10);
+        report_intersections(segments, [](const intersection& r) {
+            if (r.overlap) {
+                cout << "overlap " << r.p.x << " " << r.p.y << " " << r.q.x << " " << r.q.y;
+            } else {
+                cout << "point " << r.p.x << " " << r.p.y;
+            }
+            for (int id : r.ids) {
+                cout << " " << id;
+            }
+            cout << "\n";
+        });
+        return 0;
+    }
     exist(segments);
     return 0;
 }
\ No newline at end of file
@@ -5,6 +5,12 @@
 #include <iomanip>
 #include <cmath>
 #include <string>
+#include <limits>
+#include <cstdlib>
+#include <cfloat>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 using namespace std;
 
@@ -101,16 +107,140 @@ long double sqrt_bin_search(long double val) {
     return r;
 }
 
-int main() {
+// Points strictly inside the octagon spanned by the x, y, x + y and x - y
+// extremes are interior to the hull and cannot be diameter endpoints.
+const long long octagon_limit = 1LL << 30;
+const double octagon_eps = DBL_EPSILON / 2;
+const double octagon_errbound = (3.0 + 16.0 * octagon_eps) * octagon_eps;
+
+vector<point> octagon(const vector<point>& points) {
+    point ext[8];
+    fill(ext, ext + 8, points[0]);
+    for (const point& p : points) {
+        if (p.y < ext[0].y) {
+            ext[0] = p;
+        }
+        if (p.x - p.y > ext[1].x - ext[1].y) {
+            ext[1] = p;
+        }
+        if (p.x > ext[2].x) {
+            ext[2] = p;
+        }
+        if (p.x + p.y > ext[3].x + ext[3].y) {
+            ext[3] = p;
+        }
+        if (p.y > ext[4].y) {
+            ext[4] = p;
+        }
+        if (p.x - p.y < ext[5].x - ext[5].y) {
+            ext[5] = p;
+        }
+        if (p.x < ext[6].x) {
+            ext[6] = p;
+        }
+        if (p.x + p.y < ext[7].x + ext[7].y) {
+            ext[7] = p;
+        }
+    }
+    vector<point> oct;
+    for (const point& p : ext) {
+        if (oct.empty() || p.x != oct.back().x || p.y != oct.back().y) {
+            oct.push_back(p);
+        }
+    }
+    while (oct.size() > 1 && oct.back().x == oct[0].x && oct.back().y == oct[0].y) {
+        oct.pop_back();
+    }
+    return oct;
+}
+
+bool strictly_inside(const vector<point>& oct, const point& p) {
+    for (unsigned long i = 0; i < oct.size(); i++) {
+        if (orientation({oct[i], oct[(i + 1) % oct.size()]}, p) <= 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Removes the octagon's strict interior in place and returns the number of
+// points removed; skipped (returns 0) once a coordinate reaches 2^30. With
+// AVX2 a point goes only if its double cross products clear the error bound.
+unsigned long octagon_filter(vector<point>& points) {
+    unsigned long n = points.size();
+    if (n < 8) {
+        return 0;
+    }
+    for (const point& p : points) {
+        if (llabs(p.x) >= octagon_limit || llabs(p.y) >= octagon_limit) {
+            return 0;
+        }
+    }
+    vector<point> oct = octagon(points);
+    if (oct.size() < 3) {
+        return 0;
+    }
+    unsigned long w = 0;
+    unsigned long i = 0;
+#ifdef __AVX2__
+    int k = oct.size();
+    __m256d ax[8], ay[8], ex[8], ey[8];
+    for (int e = 0; e < k; e++) {
+        ax[e] = _mm256_set1_pd(oct[e].x);
+        ay[e] = _mm256_set1_pd(oct[e].y);
+        ex[e] = _mm256_set1_pd(oct[(e + 1) % k].x - oct[e].x);
+        ey[e] = _mm256_set1_pd(oct[(e + 1) % k].y - oct[e].y);
+    }
+    const __m256i low = _mm256_setr_epi32(0, 4, 2, 6, 0, 4, 2, 6);
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    const __m256d errbound = _mm256_set1_pd(octagon_errbound);
+    for (; i + 4 <= n; i += 4) {
+        __m256i v0 = _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i*) &points[i]), low);
+        __m256i v1 = _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i*) &points[i + 2]), low);
+        __m128i lo0 = _mm256_castsi256_si128(v0);
+        __m128i lo1 = _mm256_castsi256_si128(v1);
+        __m256d px = _mm256_cvtepi32_pd(_mm_unpacklo_epi64(lo0, lo1));
+        __m256d py = _mm256_cvtepi32_pd(_mm_unpackhi_epi64(lo0, lo1));
+        __m256d inside = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+        for (int e = 0; e < k; e++) {
+            __m256d l = _mm256_mul_pd(ex[e], _mm256_sub_pd(py, ay[e]));
+            __m256d r = _mm256_mul_pd(ey[e], _mm256_sub_pd(px, ax[e]));
+            __m256d bound = _mm256_mul_pd(errbound, _mm256_add_pd(_mm256_andnot_pd(sign, l), _mm256_andnot_pd(sign, r)));
+            inside = _mm256_and_pd(inside, _mm256_cmp_pd(_mm256_sub_pd(l, r), bound, _CMP_GT_OQ));
+        }
+        int mask = _mm256_movemask_pd(inside);
+        for (int j = 0; j < 4; j++) {
+            if (!(mask >> j & 1)) {
+                points[w++] = points[i + j];
+            }
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        if (!strictly_inside(oct, points[i])) {
+            points[w++] = points[i];
+        }
+    }
+    points.resize(w);
+    return n - w;
+}
+
+int main(int argc, char* argv[]) {
+    string mode = argc > 1 ? argv[1] : "";
     int n;
     cin >> n;
-    set<point, simple_comp> points;
+    vector<point> input(n);
     for (int i = 0; i < n; i++) {
-        long long x, y;
-        cin >> x >> y;
-        points.insert({x, y});
-        if (y < minPoint.y) {
-            minPoint = {x, y};
+        cin >> input[i].x >> input[i].y;
+    }
+    if (mode == "octagon") {
+        cerr << "octagon filter removed " << octagon_filter(input) << " of " << n << " points" << endl;
+    }
+    set<point, simple_comp> points;
+    for (const point& p : input) {
+        points.insert(p);
+        if (p.y < minPoint.y) {
+            minPoint = p;
         }
     }
 